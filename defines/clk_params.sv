@@ -35,6 +35,7 @@ package clk_params;
     localparam real SYS_CLK_FREQUENCY_MHZ = (INPUT_CLK_FREQUENCY_MHZ / MMCM_DIV * MMCM_MUL) / MMCM_DIV_0;
     localparam real SYS_CLK_PERIOD_NS     = 1000.000 / SYS_CLK_FREQUENCY_MHZ;
     // => SYS_CLK: (100 MHz / 1 * 10) / 20 = 50 MHz
+    // Note: synthesis can override MMCM_MUL/MMCM_DIV_0 (synth/top.sv), `make fmax` sweeps them
 
     // --------------------------------------------------------------------------------------------
     // |                                        VGA Clock                                         |
@@ -13,8 +13,17 @@ package constants;
     // --------------------------------------------------------------------------------------------
     // |                                   Wishbone Constants                                     |
     // --------------------------------------------------------------------------------------------
-    localparam bit [31:0] MEMORY_START = 32'h0001_0000;
-    localparam bit [31:0] MEMORY_SIZE  = 32'h0000_2000;
+    // Local memory of the harts 1 ... NUM_CORES - 1 (code and data, private to every hart)
+    localparam bit [31:0] LOCAL_START = 32'h0000_8000;
+    localparam bit [31:0] LOCAL_SIZE  = 32'h0000_0400;
+
+    // Note: the memory size is configured by the mcu parameter MEMORY_SIZE_KB
+    localparam bit [31:0] MEMORY_START    = 32'h0001_0000;
+    localparam bit [31:0] MEMORY_SIZE_MAX = 32'h0001_0000; // up to TCM_START
+
+    // Tightly coupled data memory (memory port only, not part of the interconnect, one per hart)
+    localparam bit [31:0] TCM_START = 32'h0002_0000;
+    localparam bit [31:0] TCM_SIZE  = 32'h0000_0400;
 
     localparam bit [31:0] LEDS_START = 32'h0008_0000;
     localparam bit [31:0] LEDS_SIZE  = 32'h0000_0001;
@@ -32,13 +41,23 @@ package constants;
     localparam bit [31:0] UART_SIZE  = 32'h0000_0001;
 
     localparam bit [31:0] TIMER_START = 32'h0008_5000;
-    localparam bit [31:0] TIMER_SIZE  = 32'h0000_0005;
+    localparam bit [31:0] TIMER_SIZE  = 32'h0000_0019; // 8 + 4 registers per compare channel + latched mtimeh
+
+    localparam bit [31:0] BUS_MONITOR_START = 32'h0008_6000;
+    localparam bit [31:0] BUS_MONITOR_SIZE  = 32'h0000_00D0; // 16 registers + 16 per interconnect slave
+
+    localparam bit [31:0] MAILBOX_START = 32'h0008_7000;
+    localparam bit [31:0] MAILBOX_SIZE  = 32'h0000_0010; // 8 registers + 1 message per hart (up to 8)
 
     localparam bit [31:0] VGA_START = 32'h0009_0000;
     localparam bit [31:0] VGA_SIZE  = 32'h0000_9600; // 640 * 480 pixel with 4 bit color depth
 
     localparam bit [31:0] TEST_START = 32'h0012_0000;
-    localparam bit [31:0] TEST_SIZE  = 32'h0000_0005;
+    localparam bit [31:0] TEST_SIZE  = 32'h0000_0007;
+
+    // Execute-in-place window of the QSPI configuration flash (read only, see wishbone_flash.sv)
+    localparam bit [31:0] FLASH_START = 32'h0020_0000;
+    localparam bit [31:0] FLASH_SIZE  = 32'h0004_0000; // 1 MB
 
     // --------------------------------------------------------------------------------------------
     // |                                    Address Constants                                     |
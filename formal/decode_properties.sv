@@ -0,0 +1,146 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: decode_properties.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Forwarding in decode_stage.                                                                  |
+// |                                                                                              |
+// | A source register is taken from the youngest matching forwarding input (execute, memory,     |
+// | writeback), otherwise from the register file. The register file is written through          |
+// | wb_forwarding_in, one register chosen by the solver (any_address) is tracked to know its     |
+// | content.                                                                                     |
+// |                                                                                              |
+// | Assertions (only for instructions that read the register, x0 always reads 0):                |
+// |     - an instruction leaving decode as VALID carries the forwarded or register file value    |
+// |     - the youngest match without data (e.g. a load in execute) is a hazard: decode must not  |
+// |       accept the next instruction (status_backwards_out != READY)                            |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module decode_properties (
+    input logic clk,
+    input logic rst,
+
+    input logic [31:0]  instruction_in,
+    input forwarding::t exe_forwarding_in,
+    input forwarding::t mem_forwarding_in,
+    input forwarding::t wb_forwarding_in,
+
+    input logic [31:0] rs1_data_reg_out,
+    input logic [31:0] rs2_data_reg_out,
+
+    input pipeline_status::forwards_t  status_forwards_in,
+    input pipeline_status::forwards_t  status_forwards_out,
+    input pipeline_status::backwards_t status_backwards_in,
+    input pipeline_status::backwards_t status_backwards_out
+);
+    import pipeline_status::*;
+
+    logic past_valid = 0;
+    always @(posedge clk) begin
+        past_valid <= 1;
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                      Operand model                                       |
+    // --------------------------------------------------------------------------------------------
+
+    // Register file content of any_address
+    logic  [4:0] any_address;
+    logic [31:0] register_value;
+    assign any_address = $anyconst;
+
+    always @(posedge clk) begin
+        if (rst) begin
+            register_value <= 0;
+        end
+        else if (wb_forwarding_in.data_valid && wb_forwarding_in.address == any_address) begin
+            register_value <= wb_forwarding_in.data;
+        end
+    end
+
+    // Instructions reading rs1/rs2 (RV32I + Zicsr opcodes)
+    logic [6:0] opcode;
+    logic [2:0] funct3;
+    logic [4:0] rs1, rs2;
+    logic       reads_rs1, reads_rs2;
+    assign opcode = instruction_in[6:0];
+    assign funct3 = instruction_in[14:12];
+    assign rs1    = instruction_in[19:15];
+    assign rs2    = instruction_in[24:20];
+
+    always @(*) begin
+        case (opcode)
+            7'b1100111, 7'b0000011, 7'b0010011: begin reads_rs1 = 1; reads_rs2 = 0; end // jalr, load, op-imm
+            7'b1100011, 7'b0100011, 7'b0110011: begin reads_rs1 = 1; reads_rs2 = 1; end // branch, store, op
+            7'b1110011:                         begin reads_rs1 = funct3 != 0 && !funct3[2]; reads_rs2 = 0; end // csr
+            default:                            begin reads_rs1 = 0; reads_rs2 = 0; end
+        endcase
+    end
+
+    // Youngest matching forwarding input
+    function automatic logic matches(forwarding::t forwarding, logic [4:0] address);
+        return address != 0 && forwarding.address == address;
+    endfunction
+
+    logic        hazard1, hazard2;
+    logic        known1, known2;
+    logic [31:0] value1, value2;
+
+    always @(*) begin
+        hazard1 = 0;
+        known1  = 1;
+        if      (rs1 == 0)                             value1 = 0;
+        else if (matches(exe_forwarding_in, rs1))      begin value1 = exe_forwarding_in.data; hazard1 = !exe_forwarding_in.data_valid; end
+        else if (matches(mem_forwarding_in, rs1))      begin value1 = mem_forwarding_in.data; hazard1 = !mem_forwarding_in.data_valid; end
+        else if (matches(wb_forwarding_in, rs1) && wb_forwarding_in.data_valid) value1 = wb_forwarding_in.data;
+        else if (rs1 == any_address)                   value1 = register_value;
+        else                                           begin value1 = 0; known1 = 0; end
+
+        hazard2 = 0;
+        known2  = 1;
+        if      (rs2 == 0)                             value2 = 0;
+        else if (matches(exe_forwarding_in, rs2))      begin value2 = exe_forwarding_in.data; hazard2 = !exe_forwarding_in.data_valid; end
+        else if (matches(mem_forwarding_in, rs2))      begin value2 = mem_forwarding_in.data; hazard2 = !mem_forwarding_in.data_valid; end
+        else if (matches(wb_forwarding_in, rs2) && wb_forwarding_in.data_valid) value2 = wb_forwarding_in.data;
+        else if (rs2 == any_address)                   value2 = register_value;
+        else                                           begin value2 = 0; known2 = 0; end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Assertions                                        |
+    // --------------------------------------------------------------------------------------------
+
+    // A valid instruction is taken over by decode in this cycle
+    logic accept;
+    assign accept = !rst && status_forwards_in == VALID && status_backwards_in == READY && status_backwards_out == READY;
+
+    always @(*) begin
+        if (!rst && status_forwards_in == VALID && status_backwards_in == READY) begin
+            if ((reads_rs1 && hazard1) || (reads_rs2 && hazard2)) begin
+                assert (status_backwards_out != READY);
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        if (past_valid && !rst && $past(accept) && status_forwards_out == VALID) begin
+            if ($past(reads_rs1 && known1 && !hazard1)) assert (rs1_data_reg_out == $past(value1));
+            if ($past(reads_rs2 && known2 && !hazard2)) assert (rs2_data_reg_out == $past(value2));
+        end
+    end
+
+    always @(posedge clk) begin
+        if (!rst) begin
+            cover (past_valid && $past(accept && reads_rs1 && matches(exe_forwarding_in, rs1)) && status_forwards_out == VALID);
+            cover (!rst && status_forwards_in == VALID && reads_rs1 && hazard1);
+        end
+    end
+
+endmodule
@@ -0,0 +1,90 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: execute_properties.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Operand use in execute_stage: the forwarded operands (rs1_data_in/rs2_data_in) must be the   |
+// | ones the result is computed from. For every register/immediate ALU instruction taken over    |
+// | by execute, the next VALID output carries the instruction and its result in rd_data.         |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module execute_properties (
+    input logic clk,
+    input logic rst,
+
+    input logic [31:0]   rs1_data_in,
+    input logic [31:0]   rs2_data_in,
+    input instruction::t instruction_in,
+    input logic [31:0]   rd_data_reg_out,
+    input instruction::t instruction_reg_out,
+
+    input pipeline_status::forwards_t  status_forwards_in,
+    input pipeline_status::forwards_t  status_forwards_out,
+    input pipeline_status::backwards_t status_backwards_in,
+    input pipeline_status::backwards_t status_backwards_out
+);
+    import pipeline_status::*;
+
+    logic past_valid = 0;
+    always @(posedge clk) begin
+        past_valid <= 1;
+    end
+
+    logic [31:0] immediate;
+    logic [4:0]  shift;
+    logic [31:0] result;
+    logic        alu;
+
+    assign immediate = instruction_in.immediate;
+
+    always @(*) begin
+        alu   = 1;
+        shift = 0;
+        case (instruction_in.op)
+            op::ADD:   result = rs1_data_in + rs2_data_in;
+            op::SUB:   result = rs1_data_in - rs2_data_in;
+            op::SLL:   result = rs1_data_in << rs2_data_in[4:0];
+            op::SLT:   result = 32'($signed(rs1_data_in) < $signed(rs2_data_in));
+            op::SLTU:  result = 32'(rs1_data_in < rs2_data_in);
+            op::XOR:   result = rs1_data_in ^ rs2_data_in;
+            op::SRL:   result = rs1_data_in >> rs2_data_in[4:0];
+            op::SRA:   result = 32'($signed(rs1_data_in) >>> rs2_data_in[4:0]);
+            op::OR:    result = rs1_data_in | rs2_data_in;
+            op::AND:   result = rs1_data_in & rs2_data_in;
+            op::ADDI:  result = rs1_data_in + immediate;
+            op::SLTI:  result = 32'($signed(rs1_data_in) < $signed(immediate));
+            op::SLTIU: result = 32'(rs1_data_in < immediate);
+            op::XORI:  result = rs1_data_in ^ immediate;
+            op::ORI:   result = rs1_data_in | immediate;
+            op::ANDI:  result = rs1_data_in & immediate;
+            op::SLLI:  begin shift = immediate[4:0]; result = rs1_data_in << shift; end
+            op::SRLI:  begin shift = immediate[4:0]; result = rs1_data_in >> shift; end
+            op::SRAI:  begin shift = immediate[4:0]; result = 32'($signed(rs1_data_in) >>> shift); end
+            default:   begin result = 0; alu = 0; end
+        endcase
+    end
+
+    logic accept;
+    assign accept = !rst && status_forwards_in == VALID && status_backwards_in == READY && status_backwards_out == READY;
+
+    always @(posedge clk) begin
+        if (past_valid && !rst && $past(accept && alu) && status_forwards_out == VALID) begin
+            assert (instruction_reg_out == $past(instruction_in));
+            assert (rd_data_reg_out == $past(result));
+        end
+    end
+
+    always @(posedge clk) begin
+        if (!rst) begin
+            cover (past_valid && $past(accept && alu) && status_forwards_out == VALID);
+        end
+    end
+
+endmodule
@@ -0,0 +1,49 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: formal_decode_stage.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Top level of the decode_stage task (see hades-v.sby): decode_stage with free instructions,   |
+// | forwarding inputs and status/jump inputs. The solver starts in reset. The task is skipped    |
+// | while rtl/decode_stage.sv still wraps the ref_* model.                                       |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module formal_decode_stage (
+    input logic clk,
+    input logic rst,
+    input logic [31:0]  instruction_in,
+    input logic [31:0]  program_counter_in,
+    input forwarding::t exe_forwarding_in,
+    input forwarding::t mem_forwarding_in,
+    input forwarding::t wb_forwarding_in,
+    input pipeline_status::forwards_t  status_forwards_in,
+    input pipeline_status::backwards_t status_backwards_in,
+    input logic [31:0] jump_address_backwards_in
+);
+    initial assume (rst);
+
+    logic [31:0]   rs1_data_reg_out;
+    logic [31:0]   rs2_data_reg_out;
+    logic [31:0]   program_counter_reg_out;
+    instruction::t instruction_reg_out;
+    pipeline_status::forwards_t  status_forwards_out;
+    pipeline_status::backwards_t status_backwards_out;
+    logic [31:0] jump_address_backwards_out;
+
+    decode_stage dut(.*);
+    decode_properties forwarding(.*);
+
+    pipeline_properties #(
+        .DATA_WIDTH(96 + $bits(instruction::t))
+    ) pipeline (
+        .data_out({rs1_data_reg_out, rs2_data_reg_out, program_counter_reg_out, instruction_reg_out}),
+        .*
+    );
+endmodule
@@ -0,0 +1,51 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: formal_execute_stage.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Top level of the execute_stage task (see hades-v.sby): execute_stage with free operands,     |
+// | instructions and status/jump inputs. The solver starts in reset. The task is skipped while   |
+// | rtl/execute_stage.sv still wraps the ref_* model.                                            |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module formal_execute_stage (
+    input logic clk,
+    input logic rst,
+    input logic [31:0]   rs1_data_in,
+    input logic [31:0]   rs2_data_in,
+    input instruction::t instruction_in,
+    input logic [31:0]   program_counter_in,
+    input pipeline_status::forwards_t  status_forwards_in,
+    input pipeline_status::backwards_t status_backwards_in,
+    input logic [31:0] jump_address_backwards_in
+);
+    initial assume (rst);
+
+    logic [31:0]   source_data_reg_out;
+    logic [31:0]   rd_data_reg_out;
+    instruction::t instruction_reg_out;
+    logic [31:0]   program_counter_reg_out;
+    logic [31:0]   next_program_counter_reg_out;
+    forwarding::t  forwarding_out;
+    pipeline_status::forwards_t  status_forwards_out;
+    pipeline_status::backwards_t status_backwards_out;
+    logic [31:0] jump_address_backwards_out;
+
+    execute_stage dut(.*);
+    execute_properties operands(.*);
+
+    pipeline_properties #(
+        .DATA_WIDTH(128 + $bits(instruction::t))
+    ) pipeline (
+        .data_out({source_data_reg_out, rd_data_reg_out, instruction_reg_out, program_counter_reg_out,
+                   next_program_counter_reg_out}),
+        .*
+    );
+endmodule
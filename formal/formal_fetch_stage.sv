@@ -0,0 +1,63 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: formal_fetch_stage.sv
+ */
+
+`include "formal.svh"
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Top level of the fetch_stage task (see hades-v.sby): fetch_stage with free slave responses   |
+// | and free status/jump inputs from decode. The solver starts in reset. The task is skipped     |
+// | while rtl/fetch_stage.sv still wraps the ref_* model.                                        |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module formal_fetch_stage (
+    input logic clk,
+    input logic rst,
+    input pipeline_status::backwards_t status_backwards_in,
+    input logic [31:0] jump_address_backwards_in,
+    `FORMAL_SLAVE_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wb();
+    `FORMAL_DRIVE_SLAVE(wb)
+
+    logic [31:0] instruction_reg_out;
+    logic [31:0] program_counter_reg_out;
+    pipeline_status::forwards_t status_forwards_out;
+
+    fetch_stage dut (
+        .clk(clk),
+        .rst(rst),
+        .wb(wb.master),
+        .instruction_reg_out(instruction_reg_out),
+        .program_counter_reg_out(program_counter_reg_out),
+        .status_forwards_out(status_forwards_out),
+        .status_backwards_in(status_backwards_in),
+        .jump_address_backwards_in(jump_address_backwards_in)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wb, 0, 0)
+
+    pipeline_properties #(
+        .DATA_WIDTH(64),
+        .HAS_PREDECESSOR(0)
+    ) pipeline (
+        .clk(clk),
+        .rst(rst),
+        .data_out({instruction_reg_out, program_counter_reg_out}),
+        .status_forwards_in(pipeline_status::VALID),
+        .status_forwards_out(status_forwards_out),
+        .status_backwards_in(status_backwards_in),
+        .status_backwards_out(pipeline_status::READY),
+        .jump_address_backwards_in(jump_address_backwards_in),
+        .jump_address_backwards_out(jump_address_backwards_in)
+    );
+endmodule
@@ -0,0 +1,62 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: formal_memory_stage.sv
+ */
+
+`include "formal.svh"
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Top level of the memory_stage task (see hades-v.sby): memory_stage with free slave           |
+// | responses, instructions and status/jump inputs. The solver starts in reset. The task is      |
+// | skipped while rtl/memory_stage.sv still wraps the ref_* model.                               |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module formal_memory_stage (
+    input logic clk,
+    input logic rst,
+    input logic [31:0]   source_data_in,
+    input logic [31:0]   rd_data_in,
+    input instruction::t instruction_in,
+    input logic [31:0]   program_counter_in,
+    input logic [31:0]   next_program_counter_in,
+    input pipeline_status::forwards_t  status_forwards_in,
+    input pipeline_status::backwards_t status_backwards_in,
+    input logic [31:0] jump_address_backwards_in,
+    `FORMAL_SLAVE_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wb();
+    `FORMAL_DRIVE_SLAVE(wb)
+
+    logic [31:0]   source_data_reg_out;
+    logic [31:0]   rd_data_reg_out;
+    instruction::t instruction_reg_out;
+    logic [31:0]   program_counter_reg_out;
+    logic [31:0]   next_program_counter_reg_out;
+    forwarding::t  forwarding_out;
+    pipeline_status::forwards_t  status_forwards_out;
+    pipeline_status::backwards_t status_backwards_out;
+    logic [31:0] jump_address_backwards_out;
+
+    memory_stage dut (
+        .wb(wb.master),
+        .*
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wb, 0, 0)
+
+    pipeline_properties #(
+        .DATA_WIDTH(128 + $bits(instruction::t))
+    ) pipeline (
+        .data_out({source_data_reg_out, rd_data_reg_out, instruction_reg_out, program_counter_reg_out,
+                   next_program_counter_reg_out}),
+        .*
+    );
+endmodule
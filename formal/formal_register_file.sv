@@ -0,0 +1,34 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: formal_register_file.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Top level of the register_file task (see hades-v.sby): register_file with free read/write    |
+// | ports. The solver starts in reset. The task is skipped while rtl/register_file.sv still      |
+// | wraps the ref_* model.                                                                       |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module formal_register_file (
+    input logic clk,
+    input logic rst,
+    input logic  [4:0] read_address1,
+    input logic  [4:0] read_address2,
+    input logic  [4:0] write_address,
+    input logic [31:0] write_data,
+    input logic        write_enable
+);
+    initial assume (rst);
+
+    logic [31:0] read_data1;
+    logic [31:0] read_data2;
+
+    register_file dut(.*);
+    register_file_properties properties(.*);
+endmodule
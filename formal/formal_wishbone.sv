@@ -0,0 +1,289 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: formal_wishbone.sv
+ */
+
+`include "formal.svh"
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Top levels of the wishbone tasks (see hades-v.sby): one peripheral or the interconnect with  |
+// | the bus driven by the solver. The solver starts in reset.                                    |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module formal_wishbone_leds (
+    input logic clk,
+    input logic rst,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::LEDS_START, constants::LEDS_SIZE)
+
+    logic [15:0] leds;
+    wishbone_leds #(
+        .ADDRESS(constants::LEDS_START)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .leds(leds),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 2)
+endmodule
+
+module formal_wishbone_buttons (
+    input logic clk,
+    input logic rst,
+    input logic [4:0] buttons,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::BUTTONS_START, constants::BUTTONS_SIZE)
+
+    wishbone_buttons #(
+        .ADDRESS(constants::BUTTONS_START),
+        .SIZE(constants::BUTTONS_SIZE)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .buttons(buttons),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 2)
+endmodule
+
+module formal_wishbone_switches (
+    input logic clk,
+    input logic rst,
+    input logic [15:0] switches,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::SWITCHES_START, constants::SWITCHES_SIZE)
+
+    wishbone_switches #(
+        .ADDRESS(constants::SWITCHES_START)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .switches(switches),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 2)
+endmodule
+
+module formal_wishbone_segments (
+    input logic clk,
+    input logic rst,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::SEGMENTS_START, constants::SEGMENTS_SIZE)
+
+    logic [7:0] segments;
+    logic [3:0] segments_select;
+    wishbone_segments #(
+        .ADDRESS(constants::SEGMENTS_START)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .segments(segments),
+        .segments_select(segments_select),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 2)
+endmodule
+
+module formal_wishbone_uart (
+    input logic clk,
+    input logic rst,
+    input logic rx_serial_in,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::UART_START, constants::UART_SIZE)
+
+    // 4 cycles per bit, keeps the state space of the serial side small
+    logic tx_serial_out;
+    logic interrupt;
+    wishbone_uart #(
+        .ADDRESS(constants::UART_START),
+        .SIZE(constants::UART_SIZE),
+        .BAUD_RATE(250_000),
+        .CLK_FREQUENCY_MHZ(1.0)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .rx_serial_in(rx_serial_in),
+        .tx_serial_out(tx_serial_out),
+        .interrupt(interrupt),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 2)
+endmodule
+
+module formal_wishbone_timer (
+    input logic clk,
+    input logic rst,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::TIMER_START, constants::TIMER_SIZE)
+
+    logic       interrupt;
+    logic [3:0] pwm;
+    wishbone_timer #(
+        .ADDRESS(constants::TIMER_START),
+        .CLK_FREQUENCY_MHZ(1)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .hart(3'd0),
+        .interrupt(interrupt),
+        .pwm(pwm),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 2)
+endmodule
+
+module formal_wishbone_test (
+    input logic clk,
+    input logic rst,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::TEST_START, constants::TEST_SIZE)
+
+    // stall/error registers answer after 3 wait states
+    logic interrupt;
+    wishbone_test #(
+        .ADDRESS(constants::TEST_START),
+        .SIZE(constants::TEST_SIZE)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .interrupt(interrupt),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 4)
+endmodule
+
+module formal_wishbone_monitor (
+    input logic clk,
+    input logic rst,
+    // observed bus
+    input logic [31:0] bus_adr,
+    input logic  [3:0] bus_sel,
+    input logic [31:0] bus_dat_mosi,
+    input logic [31:0] bus_dat_miso,
+    input logic        bus_cyc,
+    input logic        bus_stb,
+    input logic        bus_we,
+    input logic        bus_ack,
+    input logic        bus_err,
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    wishbone_interface wishbone();
+    `FORMAL_DRIVE_MASTER(wishbone)
+    `FORMAL_ADDRESSED(constants::BUS_MONITOR_START, constants::BUS_MONITOR_SIZE)
+
+    wishbone_interface bus();
+    assign bus.adr      = bus_adr;
+    assign bus.sel      = bus_sel;
+    assign bus.dat_mosi = bus_dat_mosi;
+    assign bus.dat_miso = bus_dat_miso;
+    assign bus.cyc      = bus_cyc;
+    assign bus.stb      = bus_stb;
+    assign bus.we       = bus_we;
+    assign bus.ack      = bus_ack;
+    assign bus.err      = bus_err;
+
+    localparam int NUM_SLAVES = 2;
+    wishbone_monitor #(
+        .ADDRESS(constants::BUS_MONITOR_START),
+        .SIZE(constants::BUS_MONITOR_SIZE),
+        .NUM_SLAVES(NUM_SLAVES),
+        .SLAVE_ADDRESS({constants::LEDS_START, constants::TEST_START}),
+        .SLAVE_SIZE({constants::LEDS_SIZE, constants::TEST_SIZE})
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .bus(bus.monitor),
+        .wishbone(wishbone.slave)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, wishbone, 1, 2)
+endmodule
+
+module formal_wishbone_interconnect (
+    input logic clk,
+    input logic rst,
+    // responses of the two slaves
+    input logic [31:0] slave_dat_miso [2],
+    input logic        slave_ack [2],
+    input logic        slave_err [2],
+    `FORMAL_MASTER_INPUTS
+);
+    initial assume (rst);
+
+    localparam int NUM_SLAVES = 2;
+
+    wishbone_interface master();
+    wishbone_interface slaves[NUM_SLAVES]();
+    `FORMAL_DRIVE_MASTER(master)
+
+    for (genvar slave = 0; slave < NUM_SLAVES; slave++) begin: slave_side
+        assign slaves[slave].dat_miso = slave_dat_miso[slave];
+        assign slaves[slave].ack      = slave_ack[slave];
+        assign slaves[slave].err      = slave_err[slave];
+        `FORMAL_WISHBONE(wishbone_check, slaves[slave], 0, 0)
+    end
+
+    wishbone_interconnect #(
+        .NUM_SLAVES(NUM_SLAVES),
+        .SLAVE_ADDRESS({constants::LEDS_START, constants::TEST_START}),
+        .SLAVE_SIZE({constants::LEDS_SIZE, constants::TEST_SIZE})
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .master(master.slave),
+        .slaves(slaves)
+    );
+
+    `FORMAL_WISHBONE(wishbone_check, master, 1, 0)
+endmodule
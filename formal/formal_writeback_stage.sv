@@ -0,0 +1,52 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: formal_writeback_stage.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Top level of the writeback_stage task (see hades-v.sby): writeback_stage with free           |
+// | instructions, interrupts and status. The solver starts in reset. The task is skipped while   |
+// | rtl/writeback_stage.sv still wraps the ref_* model.                                          |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module formal_writeback_stage (
+    input logic clk,
+    input logic rst,
+    input logic [31:0]   source_data_in,
+    input logic [31:0]   rd_data_in,
+    input instruction::t instruction_in,
+    input logic [31:0]   program_counter_in,
+    input logic [31:0]   next_program_counter_in,
+    input logic          external_interrupt_in,
+    input logic          timer_interrupt_in,
+    input pipeline_status::forwards_t status_forwards_in
+);
+    initial assume (rst);
+
+    forwarding::t forwarding_out;
+    pipeline_status::backwards_t status_backwards_out;
+    logic [31:0] jump_address_backwards_out;
+
+    writeback_stage dut(.*);
+
+    pipeline_properties #(
+        .DATA_WIDTH(1),
+        .HAS_SUCCESSOR(0)
+    ) pipeline (
+        .clk(clk),
+        .rst(rst),
+        .data_out(1'b0),
+        .status_forwards_in(status_forwards_in),
+        .status_forwards_out(pipeline_status::BUBBLE),
+        .status_backwards_in(pipeline_status::READY),
+        .status_backwards_out(status_backwards_out),
+        .jump_address_backwards_in(jump_address_backwards_out),
+        .jump_address_backwards_out(jump_address_backwards_out)
+    );
+endmodule
@@ -0,0 +1,119 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: pipeline_properties.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | pipeline_status stall/flush invariants of one stage.                                         |
+// |                                                                                              |
+// | data_out are the output registers of the stage (concatenated), the checks on them only       |
+// | apply to non-bubble outputs. Stages without successor (writeback) set HAS_SUCCESSOR = 0,     |
+// | stages without predecessor (fetch) HAS_PREDECESSOR = 0.                                      |
+// |                                                                                              |
+// | Assertions:                                                                                  |
+// |     - the first output after reset is a bubble                                               |
+// |     - a flush (JUMP from the successor) turns the next output into a bubble                  |
+// |     - a stall from the successor holds the output (status and data)                          |
+// |     - a stall from the successor can not be answered with READY while the output is valid    |
+// |     - a JUMP from the successor is passed on with its address (the older instruction wins)   |
+// | Assumptions: legal status encodings from the neighbours.                                     |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module pipeline_properties #(
+    parameter int DATA_WIDTH = 32,
+    parameter bit HAS_PREDECESSOR = 1,
+    parameter bit HAS_SUCCESSOR = 1
+) (
+    input logic clk,
+    input logic rst,
+
+    input logic [DATA_WIDTH-1:0] data_out,
+
+    input pipeline_status::forwards_t  status_forwards_in,
+    input pipeline_status::forwards_t  status_forwards_out,
+    input pipeline_status::backwards_t status_backwards_in,
+    input pipeline_status::backwards_t status_backwards_out,
+    input logic [31:0] jump_address_backwards_in,
+    input logic [31:0] jump_address_backwards_out
+);
+    import pipeline_status::*;
+
+    logic past_valid = 0;
+    always @(posedge clk) begin
+        past_valid <= 1;
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                       Assumptions                                        |
+    // --------------------------------------------------------------------------------------------
+
+    always @(*) begin
+        if (HAS_PREDECESSOR) begin
+            assume (status_forwards_in <= EBREAK);
+        end
+        if (HAS_SUCCESSOR) begin
+            assume (status_backwards_in <= JUMP);
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Assertions                                        |
+    // --------------------------------------------------------------------------------------------
+
+    always @(*) begin
+        if (!rst) begin
+            assert (status_backwards_out <= JUMP);
+            if (HAS_SUCCESSOR) begin
+                assert (status_forwards_out <= EBREAK);
+            end
+        end
+    end
+
+    if (HAS_SUCCESSOR) begin: successor
+        always @(posedge clk) begin
+            if (past_valid && !rst) begin
+                // reset
+                if ($past(rst)) begin
+                    assert (status_forwards_out == BUBBLE);
+                end
+                // flush
+                else if ($past(status_backwards_in) == JUMP) begin
+                    assert (status_forwards_out == BUBBLE);
+                end
+                // stall
+                else if ($past(status_backwards_in) == STALL) begin
+                    assert (status_forwards_out == $past(status_forwards_out));
+                    if (status_forwards_out != BUBBLE) begin
+                        assert (data_out == $past(data_out));
+                    end
+                end
+            end
+        end
+
+        always @(*) begin
+            if (!rst && HAS_PREDECESSOR) begin
+                if (status_backwards_in == STALL && status_forwards_out != BUBBLE) begin
+                    assert (status_backwards_out != READY);
+                end
+                if (status_backwards_in == JUMP) begin
+                    assert (status_backwards_out == JUMP);
+                    assert (jump_address_backwards_out == jump_address_backwards_in);
+                end
+            end
+        end
+
+        always @(posedge clk) begin
+            if (!rst) begin
+                cover (past_valid && $past(status_backwards_in) == STALL && status_forwards_out == VALID);
+                cover (past_valid && $past(status_backwards_in) == JUMP);
+            end
+        end
+    end
+
+endmodule
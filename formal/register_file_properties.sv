@@ -0,0 +1,69 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: register_file_properties.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | register_file: x0 always reads 0, every other register reads the last value written to it    |
+// | (0 after reset). Writes are visible after the clock edge, reads are asynchronous.            |
+// |                                                                                              |
+// | Instead of a full model, one register chosen by the solver (any_address) is tracked.         |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module register_file_properties (
+    input logic clk,
+    input logic rst,
+
+    input logic  [4:0] read_address1,
+    input logic [31:0] read_data1,
+    input logic  [4:0] read_address2,
+    input logic [31:0] read_data2,
+    input logic  [4:0] write_address,
+    input logic [31:0] write_data,
+    input logic        write_enable
+);
+
+    logic past_valid = 0;
+    always @(posedge clk) begin
+        past_valid <= 1;
+    end
+
+    logic  [4:0] any_address;
+    logic [31:0] expected;
+    assign any_address = $anyconst;
+
+    always @(posedge clk) begin
+        if (rst) begin
+            expected <= 0;
+        end
+        else if (write_enable && write_address == any_address) begin
+            expected <= write_data;
+        end
+    end
+
+    always @(*) begin
+        if (past_valid && !rst) begin
+            // x0 is never written
+            if (read_address1 == 0) assert (read_data1 == 0);
+            if (read_address2 == 0) assert (read_data2 == 0);
+
+            if (any_address != 0) begin
+                if (read_address1 == any_address) assert (read_data1 == expected);
+                if (read_address2 == any_address) assert (read_data2 == expected);
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        if (!rst) begin
+            cover (past_valid && $past(write_enable && write_address == 0) && read_address1 == 0);
+        end
+    end
+
+endmodule
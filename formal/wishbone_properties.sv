@@ -0,0 +1,131 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: wishbone_properties.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Wishbone classic handshake rules for one wishbone_interface.                                 |
+// |                                                                                              |
+// | SLAVE = 1: the checked module is the slave, the master rules are assumed.                    |
+// | SLAVE = 0: the checked module is the master, the slave rules are assumed.                    |
+// |                                                                                              |
+// | Master rules:                                                                                |
+// |     - stb only during cyc                                                                    |
+// |     - a request (cyc && stb) is held with stable adr/sel/we/dat_mosi until ack or err        |
+// |     - no request during reset                                                                |
+// | Slave rules:                                                                                 |
+// |     - ack and err only in response to a request, never both                                  |
+// |     - ack/err within MAX_LATENCY cycles (0: not checked)                                     |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module wishbone_properties #(
+    parameter bit SLAVE = 1,
+    parameter int MAX_LATENCY = 0
+) (
+    input logic clk,
+    input logic rst,
+
+    input logic [31:0] adr,
+    input logic  [3:0] sel,
+    input logic [31:0] dat_mosi,
+    input logic        cyc,
+    input logic        stb,
+    input logic        we,
+    input logic        ack,
+    input logic        err
+);
+
+    logic past_valid = 0;
+    always @(posedge clk) begin
+        past_valid <= 1;
+    end
+
+    logic request;
+    assign request = cyc && stb;
+
+    // --------------------------------------------------------------------------------------------
+    // |                                       Master rules                                       |
+    // --------------------------------------------------------------------------------------------
+
+    always @(*) begin
+        if (SLAVE) begin
+            assume (!stb || cyc);
+            assume (!rst || !request);
+        end
+        else begin
+            assert (!stb || cyc);
+            if (past_valid) assert (!rst || !request);
+        end
+    end
+
+    always @(posedge clk) begin
+        if (past_valid && !$past(rst) && !rst && $past(request) && !$past(ack) && !$past(err)) begin
+            if (SLAVE) begin
+                assume (request);
+                assume (adr == $past(adr) && sel == $past(sel) && we == $past(we));
+                assume (!we || dat_mosi == $past(dat_mosi));
+            end
+            else begin
+                assert (request);
+                assert (adr == $past(adr) && sel == $past(sel) && we == $past(we));
+                assert (!we || dat_mosi == $past(dat_mosi));
+            end
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                       Slave rules                                        |
+    // --------------------------------------------------------------------------------------------
+
+    always @(*) begin
+        if (!rst) begin
+            if (SLAVE) begin
+                assert (!(ack || err) || request);
+                assert (!(ack && err));
+            end
+            else begin
+                assume (!(ack || err) || request);
+                assume (!(ack && err));
+            end
+        end
+    end
+
+    // Cycles the current request is waiting for ack/err
+    logic [15:0] wait_cycles;
+    always @(posedge clk) begin
+        if (rst || !request || ack || err) begin
+            wait_cycles <= 0;
+        end
+        else if (wait_cycles != '1) begin
+            wait_cycles <= wait_cycles + 1;
+        end
+    end
+
+    if (MAX_LATENCY > 0) begin: latency
+        always @(*) begin
+            if (!rst && request) begin
+                if (SLAVE) assert (wait_cycles < MAX_LATENCY);
+                else       assume (wait_cycles < MAX_LATENCY);
+            end
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                          Covers                                          |
+    // --------------------------------------------------------------------------------------------
+
+    always @(posedge clk) begin
+        if (!rst) begin
+            cover (request && ack && we);
+            cover (request && ack && !we);
+            cover (past_valid && $past(request && ack) && request && ack);
+        end
+    end
+
+endmodule
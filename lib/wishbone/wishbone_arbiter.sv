@@ -0,0 +1,117 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: wishbone_arbiter.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Round robin arbiter of NUM_MASTERS masters in front of one slave (e.g. an interconnect).     |
+// | A request of an idle bus is granted within the same cycle (no additional latency), the grant |
+// | is then held until the slave answers with ack/err (or the master withdraws its request).     |
+// | The next grant goes to the first requesting master after the last granted one.               |
+// | grant is the index of the master of the current transaction (e.g. to identify the hart).     |
+// | NUM_MASTERS = 1 is a pure pass-through.                                                      |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module wishbone_arbiter #(
+    parameter int NUM_MASTERS,
+    parameter int INDEX_BITS = (NUM_MASTERS > 1) ? $clog2(NUM_MASTERS) : 1
+) (
+    input logic clk,
+    input logic rst,
+
+    wishbone_interface.slave  masters [NUM_MASTERS],
+    wishbone_interface.master slave,
+
+    output logic [INDEX_BITS-1:0] grant
+);
+
+    // --------------------------------------------------------------------------------------------
+    // |                                         Requests                                         |
+    // --------------------------------------------------------------------------------------------
+
+    logic [NUM_MASTERS-1:0] request;
+    logic            [31:0] adr      [NUM_MASTERS];
+    logic             [3:0] sel      [NUM_MASTERS];
+    logic            [31:0] dat_mosi [NUM_MASTERS];
+    logic [NUM_MASTERS-1:0] we;
+
+    for (genvar master = 0; master < NUM_MASTERS; master++) begin: master_signals
+        assign request[master]  = masters[master].cyc && masters[master].stb;
+        assign adr[master]      = masters[master].adr;
+        assign sel[master]      = masters[master].sel;
+        assign dat_mosi[master] = masters[master].dat_mosi;
+        assign we[master]       = masters[master].we;
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                       Arbitration                                        |
+    // --------------------------------------------------------------------------------------------
+
+    logic                  locked;
+    logic [INDEX_BITS-1:0] owner;
+    logic [INDEX_BITS-1:0] last;
+    logic [INDEX_BITS-1:0] selected;
+    logic                  found;
+    logic                  active;
+    logic                  done;
+
+    // First requesting master after the last granted one
+    always_comb begin
+        selected = last;
+        found    = 0;
+        for (int i = 1; i <= NUM_MASTERS; i++) begin
+            if (!found && request[(int'(last) + i) % NUM_MASTERS]) begin
+                selected = INDEX_BITS'((int'(last) + i) % NUM_MASTERS);
+                found    = 1;
+            end
+        end
+    end
+
+    assign grant  = locked ? owner : selected;
+    assign active = locked ? request[owner] : found;
+    assign done   = slave.ack || slave.err;
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            locked <= 0;
+            owner  <= 0;
+            last   <= INDEX_BITS'(NUM_MASTERS - 1);
+        end
+        else if (!locked) begin
+            if (found) begin
+                last   <= selected;
+                owner  <= selected;
+                locked <= !done;
+            end
+        end
+        else if (done || !request[owner]) begin
+            locked <= 0;
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                         Routing                                          |
+    // --------------------------------------------------------------------------------------------
+
+    // Granted master -> slave
+    assign slave.cyc      = active;
+    assign slave.stb      = active;
+    assign slave.adr      = adr[grant];
+    assign slave.sel      = sel[grant];
+    assign slave.we       = we[grant];
+    assign slave.dat_mosi = dat_mosi[grant];
+
+    // Slave -> granted master
+    for (genvar master = 0; master < NUM_MASTERS; master++) begin: master_responses
+        assign masters[master].ack      = active && grant == master && slave.ack;
+        assign masters[master].err      = active && grant == master && slave.err;
+        assign masters[master].dat_miso = slave.dat_miso;
+    end
+
+endmodule
@@ -0,0 +1,328 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: wishbone_flash.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Read only, execute-in-place window of a QSPI flash (e.g. the configuration flash of the      |
+// | Basys3) with a direct mapped line cache.                                                     |
+// |                                                                                              |
+// | [ADDRESS, ADDRESS + SIZE) is mapped to the flash bytes starting at FLASH_OFFSET (behind the  |
+// | bitstream). The fetch port and the data port share the cache. Hits are answered within the  |
+// | same cycle, misses wait until the line is read from the flash. Writes return an error.       |
+// |                                                                                              |
+// | Flash access: Quad I/O Fast Read (0xEB) with SCK = clk / 2. The first read sends the command |
+// | and enters the continuous read mode (mode bits 0xA0), every following read only sends the    |
+// | address (6 clocks), the mode bits (2 clocks) and waits 4 dummy clocks. Reset leaves the      |
+// | continuous mode (mode bit reset, 8 clocks with all lines high). The quad enable bit of the   |
+// | flash must be set (non-volatile, e.g. by the Vivado hardware manager).                       |
+// |                                                                                              |
+// | Prefetch: after a demand fill, the following line is read in the same burst (no address     |
+// | phase) unless it is already cached. A miss to any other line aborts the prefetch.            |
+// |                                                                                              |
+// | Worst case latency: a miss of one port may wait for the fill of the other port, both have to |
+// | stay below the timeout of the interconnect (255 cycles, checked below).                      |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module wishbone_flash #(
+    parameter bit [31:0] ADDRESS,
+    parameter bit [31:0] SIZE,                        // words, power of 2
+    parameter bit [23:0] FLASH_OFFSET = 24'h30_0000,  // byte offset of the window in the flash
+    parameter int        NUM_LINES    = 32,           // power of 2
+    parameter int        LINE_WORDS   = 4,            // power of 2, at least 2
+    parameter bit        PREFETCH     = 1
+) (
+    input logic clk,
+    input logic rst,
+
+    // QSPI flash (the tristate buffers of dq are part of the top level)
+    output logic       flash_cs_n,
+    output logic       flash_sck,
+    output logic [3:0] flash_dq_out,
+    output logic [3:0] flash_dq_oe,
+    input  logic [3:0] flash_dq_in,
+
+    wishbone_interface.slave fetch_port,
+    wishbone_interface.slave data_port
+);
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Parameters                                        |
+    // --------------------------------------------------------------------------------------------
+
+    localparam bit [7:0] COMMAND_QUAD_IO_READ = 8'hEB;
+    localparam bit [7:0] MODE_CONTINUOUS      = 8'hA0;
+
+    localparam int MODE_RESET_CLOCKS = 8;
+    localparam int COMMAND_CLOCKS    = 8;
+    localparam int ADDRESS_CLOCKS    = 8; // 24 bit address and 8 mode bits
+    localparam int DUMMY_CLOCKS      = 4;
+    localparam int WORD_CLOCKS       = 8;
+
+    localparam int OFFSET_BITS = $clog2(LINE_WORDS);
+    localparam int INDEX_BITS  = $clog2(NUM_LINES);
+    localparam int LINE_BITS   = $clog2(SIZE) - OFFSET_BITS;
+    localparam int TAG_BITS    = LINE_BITS - INDEX_BITS;
+
+    // Longest fill (with command), two SCK phases per clock
+    localparam int FILL_CYCLES = 2 * (COMMAND_CLOCKS + ADDRESS_CLOCKS + DUMMY_CLOCKS + WORD_CLOCKS * LINE_WORDS);
+
+    if (LINE_WORDS < 2) begin: line_size_check
+        $error("LINE_WORDS must be at least 2");
+    end
+
+    if (2 * FILL_CYCLES + 8 > 255) begin: latency_check
+        $error("LINE_WORDS too large, a miss can exceed the interconnect timeout");
+    end
+
+    typedef logic [LINE_BITS-1:0] line_t;
+
+    function automatic logic [INDEX_BITS-1:0] line_index(line_t line);
+        return line[INDEX_BITS-1:0];
+    endfunction
+
+    function automatic logic [TAG_BITS-1:0] line_tag(line_t line);
+        return line[LINE_BITS-1:INDEX_BITS];
+    endfunction
+
+    // --------------------------------------------------------------------------------------------
+    // |                                          Cache                                           |
+    // --------------------------------------------------------------------------------------------
+
+    logic [31:0]          cache_data [NUM_LINES * LINE_WORDS];
+    logic [TAG_BITS-1:0]  cache_tag  [NUM_LINES];
+    logic [NUM_LINES-1:0] cache_valid;
+
+    function automatic logic cached(line_t line);
+        return cache_valid[line_index(line)] && cache_tag[line_index(line)] == line_tag(line);
+    endfunction
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Fetch Port                                        |
+    // --------------------------------------------------------------------------------------------
+
+    logic [31:0] fetch_offset;
+    logic        fetch_valid, fetch_read, fetch_miss;
+    line_t       fetch_line;
+
+    assign fetch_offset = fetch_port.adr - ADDRESS;
+    assign fetch_valid  = fetch_port.adr >= ADDRESS && fetch_port.adr < ADDRESS + SIZE;
+    assign fetch_line   = fetch_offset[OFFSET_BITS +: LINE_BITS];
+    assign fetch_read   = fetch_port.cyc && fetch_port.stb && fetch_valid && !fetch_port.we;
+    assign fetch_miss   = fetch_read && !cached(fetch_line);
+
+    assign fetch_port.ack      = fetch_read && cached(fetch_line);
+    assign fetch_port.err      = fetch_port.cyc && fetch_port.stb && (!fetch_valid || fetch_port.we);
+    assign fetch_port.dat_miso = fetch_port.ack ? cache_data[{line_index(fetch_line), fetch_offset[OFFSET_BITS-1:0]}] : 0;
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Data Port                                         |
+    // --------------------------------------------------------------------------------------------
+
+    logic [31:0] data_offset;
+    logic        data_valid, data_read, data_miss;
+    line_t       data_line;
+
+    assign data_offset = data_port.adr - ADDRESS;
+    assign data_valid  = data_port.adr >= ADDRESS && data_port.adr < ADDRESS + SIZE;
+    assign data_line   = data_offset[OFFSET_BITS +: LINE_BITS];
+    assign data_read   = data_port.cyc && data_port.stb && data_valid && !data_port.we;
+    assign data_miss   = data_read && !cached(data_line);
+
+    assign data_port.ack      = data_read && cached(data_line);
+    assign data_port.err      = data_port.cyc && data_port.stb && (!data_valid || data_port.we);
+    assign data_port.dat_miso = data_port.ack ? cache_data[{line_index(data_line), data_offset[OFFSET_BITS-1:0]}] : 0;
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Line Fill                                         |
+    // --------------------------------------------------------------------------------------------
+
+    typedef enum logic [2:0] {
+        MODE_RESET,
+        IDLE,
+        COMMAND,
+        ADDRESS_MODE,
+        DUMMY,
+        DATA
+    } state_t;
+
+    state_t                 state;
+    logic [2:0]             count;      // clocks left in the current state - 1
+    logic                   continuous; // flash is in continuous read mode
+    logic [31:0]            shift;      // address and mode bits, most significant nibble first
+    logic [31:0]            data_shift; // received nibbles of the current word
+
+    line_t                  fill_line;
+    logic [OFFSET_BITS-1:0] fill_word;
+    logic                   fill_prefetch;
+
+    // Demand misses, the fetch port first
+    line_t       miss_line;
+    logic [23:0] miss_address;
+    assign miss_line    = fetch_miss ? fetch_line : data_line;
+    assign miss_address = FLASH_OFFSET + (24'(miss_line) << (OFFSET_BITS + 2));
+
+    line_t next_line;
+    assign next_line = fill_line + 1;
+
+    // Falling edge of SCK in the data phase: last nibble of a word received
+    logic start_fill, abort, word_done, line_done, start_prefetch;
+
+    assign start_fill = state == IDLE && (fetch_miss || data_miss);
+
+    // Another line is needed while prefetching
+    assign abort = state == DATA && flash_sck && fill_prefetch && (
+        (fetch_miss && fetch_line != fill_line) ||
+        (data_miss  && data_line  != fill_line)
+    );
+
+    assign word_done = state == DATA && flash_sck && count == 0 && !abort;
+    assign line_done = word_done && fill_word == OFFSET_BITS'(LINE_WORDS - 1);
+
+    // Continue with the next line if nothing else is waiting
+    assign start_prefetch = PREFETCH && line_done && !fill_prefetch && fill_line != '1 && !cached(next_line) && !(
+        (fetch_miss && fetch_line != fill_line && fetch_line != next_line) ||
+        (data_miss  && data_line  != fill_line && data_line  != next_line)
+    );
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            state         <= MODE_RESET;
+            count         <= 3'(MODE_RESET_CLOCKS - 1);
+            continuous    <= 0;
+            cache_valid   <= 0;
+            fill_prefetch <= 0;
+            flash_cs_n    <= 1;
+            flash_sck     <= 0;
+            flash_dq_out  <= 4'b1111;
+            flash_dq_oe   <= 4'b0000;
+        end
+        else if (state == IDLE) begin
+            if (start_fill) begin
+                fill_line     <= miss_line;
+                fill_word     <= 0;
+                fill_prefetch <= 0;
+                cache_valid[line_index(miss_line)] <= 0;
+
+                flash_cs_n <= 0;
+                if (continuous) begin
+                    state        <= ADDRESS_MODE;
+                    count        <= 3'(ADDRESS_CLOCKS - 1);
+                    shift        <= {miss_address[19:0], MODE_CONTINUOUS, 4'b0};
+                    flash_dq_out <= miss_address[23:20];
+                    flash_dq_oe  <= 4'b1111;
+                end
+                else begin
+                    state        <= COMMAND;
+                    count        <= 3'(COMMAND_CLOCKS - 1);
+                    shift        <= {miss_address, MODE_CONTINUOUS};
+                    flash_dq_out <= {3'b000, COMMAND_QUAD_IO_READ[7]};
+                    flash_dq_oe  <= 4'b0001;
+                end
+            end
+        end
+        else if (state == MODE_RESET && flash_cs_n) begin
+            // select the flash one cycle before the first clock
+            flash_cs_n  <= 0;
+            flash_dq_oe <= 4'b1111;
+        end
+        else if (!flash_sck) begin
+            // rising edge: the flash samples dq_out, the controller samples dq_in
+            flash_sck  <= 1;
+            data_shift <= {data_shift[27:0], flash_dq_in};
+        end
+        else begin
+            // falling edge: end of the current clock, drive the next one
+            flash_sck <= 0;
+            count     <= count - 1;
+
+            case (state)
+                MODE_RESET: begin
+                    if (count == 0) begin
+                        state       <= IDLE;
+                        flash_cs_n  <= 1;
+                        flash_dq_oe <= 4'b0000;
+                    end
+                end
+                COMMAND: begin
+                    if (count == 0) begin
+                        state        <= ADDRESS_MODE;
+                        count        <= 3'(ADDRESS_CLOCKS - 1);
+                        continuous   <= 1;
+                        shift        <= shift << 4;
+                        flash_dq_out <= shift[31:28];
+                        flash_dq_oe  <= 4'b1111;
+                    end
+                    else begin
+                        flash_dq_out <= {3'b000, COMMAND_QUAD_IO_READ[count - 3'd1]};
+                    end
+                end
+                ADDRESS_MODE: begin
+                    if (count == 0) begin
+                        state       <= DUMMY;
+                        count       <= 3'(DUMMY_CLOCKS - 1);
+                        flash_dq_oe <= 4'b0000;
+                    end
+                    else begin
+                        shift        <= shift << 4;
+                        flash_dq_out <= shift[31:28];
+                    end
+                end
+                DUMMY: begin
+                    if (count == 0) begin
+                        state <= DATA;
+                        count <= 3'(WORD_CLOCKS - 1);
+                    end
+                end
+                DATA: begin
+                    if (abort) begin
+                        state      <= IDLE;
+                        flash_cs_n <= 1;
+                    end
+                    else if (word_done) begin
+                        count     <= 3'(WORD_CLOCKS - 1);
+                        fill_word <= fill_word + 1;
+                    end
+
+                    if (line_done) begin
+                        cache_valid[line_index(fill_line)] <= 1;
+                        if (start_prefetch) begin
+                            fill_line     <= next_line;
+                            fill_prefetch <= 1;
+                            cache_valid[line_index(next_line)] <= 0;
+                        end
+                        else begin
+                            state      <= IDLE;
+                            flash_cs_n <= 1;
+                        end
+                    end
+                end
+                default: begin end
+            endcase
+        end
+    end
+
+    // Tags are written when a fill starts (the line is invalid until the fill is done)
+    always_ff @(posedge clk) begin
+        if (start_fill) begin
+            cache_tag[line_index(miss_line)] <= line_tag(miss_line);
+        end
+        else if (start_prefetch) begin
+            cache_tag[line_index(next_line)] <= line_tag(next_line);
+        end
+    end
+
+    // Flash bytes are received high nibble first, the lowest address is the lowest byte of a word
+    always_ff @(posedge clk) begin
+        if (word_done) begin
+            cache_data[{line_index(fill_line), fill_word}] <= {data_shift[7:0], data_shift[15:8], data_shift[23:16], data_shift[31:24]};
+        end
+    end
+
+endmodule
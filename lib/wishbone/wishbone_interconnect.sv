@@ -11,7 +11,11 @@ module wishbone_interconnect #(
     parameter int NUM_SLAVES,
     //parameter int MAX_PIPELINE_DEPTH = 1,
     parameter bit [32*NUM_SLAVES-1:0] SLAVE_ADDRESS,
-    parameter bit [32*NUM_SLAVES-1:0] SLAVE_SIZE
+    parameter bit [32*NUM_SLAVES-1:0] SLAVE_SIZE,
+    // Register the address decoder output (one additional cycle per access, shorter paths)
+    parameter bit REGISTERED_DECODE = 0,
+    // Cycles until a pending transaction is answered with err
+    parameter int TIMEOUT = 255
 ) (
     input logic clk,
     input logic rst,
@@ -24,34 +28,67 @@ module wishbone_interconnect #(
     logic ack, err;
 
     // Address decoding
+    logic [NUM_SLAVES - 1:0] address_select;
     logic [NUM_SLAVES - 1:0] select;
+    logic select_valid;
     logic invalid_address;
 
     for (genvar slave = 0; slave < NUM_SLAVES; slave++) begin
-        assign select[NUM_SLAVES - slave - 1] = &{
+        assign address_select[NUM_SLAVES - slave - 1] = &{
             master.cyc,
             master.adr >= SLAVE_ADDRESS[31 + slave * 32 : slave * 32],
             master.adr < SLAVE_ADDRESS[31 + slave * 32 : slave * 32] + SLAVE_SIZE[31 + slave * 32 : slave * 32]
         };
     end
 
-    assign invalid_address = master.cyc && master.stb && select == 0;
+    if (REGISTERED_DECODE) begin: registered_decode
+        // The decoder result is stored in the first cycle of a transaction and the slave is
+        // strobed from the second cycle on. This is allowed since the master has to keep
+        // adr stable until ack/err. The comparators are thereby removed from the path
+        // between the master and the slaves (timing closure at higher clock frequencies).
+        logic [NUM_SLAVES - 1:0] select_reg;
+        logic decoded;
+
+        always_ff @(posedge clk) begin
+            if (rst) begin
+                select_reg <= 0;
+                decoded    <= 0;
+            end
+            else if (ack || err || !(master.cyc && master.stb)) begin
+                select_reg <= 0;
+                decoded    <= 0;
+            end
+            else if (!decoded) begin
+                select_reg <= address_select;
+                decoded    <= 1;
+            end
+        end
+
+        assign select       = select_reg;
+        assign select_valid = decoded;
+    end
+    else begin: combinational_decode
+        assign select       = address_select;
+        assign select_valid = 1;
+    end
+
+    assign invalid_address = master.cyc && master.stb && select_valid && select == 0;
 
     // Bus monitor (timeout)
-    logic [7:0] count;
+    logic [$clog2(TIMEOUT + 1)-1:0] count;
     logic timeout;
     always_ff @(posedge clk) begin
         if (rst) begin
             count <= 0;
         end
         else begin
-            if (ack || err)                                   begin count <= 0;         end
-            else if (master.cyc && master.stb && count < 255) begin count <= count + 1; end
-            else                                              begin count <= 0;         end
+            if (ack || err)                                       begin count <= 0;         end
+            else if (master.cyc && master.stb && count < TIMEOUT) begin count <= count + 1; end
+            else                                                  begin count <= 0;         end
         end
     end
 
-    assign timeout = (count == 255);
+    assign timeout = (count == TIMEOUT);
     
     // Signals from slave
     logic [NUM_SLAVES-1:0] masked_ack, masked_err;
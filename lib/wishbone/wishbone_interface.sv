@@ -41,4 +41,17 @@ interface wishbone_interface;
         output err,
         output dat_miso
     );
+
+    // Passive observer (e.g. wishbone_monitor)
+    modport monitor (
+        input adr,
+        input sel,
+        input dat_mosi,
+        input dat_miso,
+        input cyc,
+        input stb,
+        input we,
+        input ack,
+        input err
+    );
 endinterface
@@ -0,0 +1,163 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: wishbone_mailbox.sv
+ */
+
+
+
+module wishbone_mailbox #(
+    parameter bit [31:0] ADDRESS,
+    parameter bit [31:0] SIZE = 16,
+    parameter int        NUM_HARTS = 1
+) (
+    input logic clk,
+    input logic rst,
+
+    // Hart of the current bus transaction (see wishbone_arbiter grant)
+    input logic [2:0] hart,
+
+    // Hart n > 0 is held in reset while run[n] is 0 (hart 0 always runs)
+    output logic [NUM_HARTS-1:0] run,
+    // Inter-processor interrupts (external interrupt of hart n)
+    output logic [NUM_HARTS-1:0] ipi,
+
+    wishbone_interface.slave wishbone
+);
+    /*
+    Wishbone mailbox and inter-processor interrupts of the multi-core mcu
+    All harts share this peripheral, the registers below are the same for every hart except
+    HARTID. Bit n of the RUN/IPI registers belongs to hart n.
+    The following registers are provided:
+    - 0x00: Hart ID register: index of the reading hart (read only, mhartid is 0 on every hart)
+    - 0x01: Number of harts (read only)
+    - 0x02: Run register: read: running harts, write: 1 bits start the harts at the reset
+            address (hart 0 always runs, all other harts are held in reset after reset)
+    - 0x03: Halt register: write: 1 bits stop the harts (held in reset), reads 0
+    - 0x04: IPI register: read: pending interrupts, write: 1 bits raise the interrupts
+    - 0x05: IPI clear register: write: 1 bits clear pending interrupts, reads 0
+    - 0x08 + n: Message register n (read/write, one word per hart, free for software use)
+    */
+
+    localparam bit [31:0] ADDRESS_HARTID    = ADDRESS + 0;
+    localparam bit [31:0] ADDRESS_NUM_HARTS = ADDRESS + 1;
+    localparam bit [31:0] ADDRESS_RUN       = ADDRESS + 2;
+    localparam bit [31:0] ADDRESS_HALT      = ADDRESS + 3;
+    localparam bit [31:0] ADDRESS_IPI       = ADDRESS + 4;
+    localparam bit [31:0] ADDRESS_IPI_CLEAR = ADDRESS + 5;
+    localparam bit [31:0] ADDRESS_MESSAGES  = ADDRESS + 8;
+
+    if (NUM_HARTS < 1 || NUM_HARTS > 8) begin: num_harts_check
+        $error("NUM_HARTS must be between 1 and 8");
+    end
+
+    if (SIZE < 8 + NUM_HARTS) begin: size_check
+        $error("SIZE is too small for the message registers of all harts");
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Registers                                         |
+    // --------------------------------------------------------------------------------------------
+
+    logic [NUM_HARTS-1:0] run_reg;
+    logic [NUM_HARTS-1:0] pending;
+    logic          [31:0] messages [NUM_HARTS];
+
+    logic [NUM_HARTS-1:0] wb_bits;
+    assign wb_bits = wb_dat_mosi[NUM_HARTS-1:0] & wb_write_mask[NUM_HARTS-1:0];
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            run_reg <= 1;
+            pending <= 0;
+            for (int i = 0; i < NUM_HARTS; i++) begin
+                messages[i] <= 0;
+            end
+        end
+        else begin
+            if (wb_write_sel != 0) begin
+                if      (wishbone.adr == ADDRESS_RUN)       begin run_reg <= run_reg | wb_bits;          end
+                else if (wishbone.adr == ADDRESS_HALT)      begin run_reg <= (run_reg & ~wb_bits) | 1; end
+                else if (wishbone.adr == ADDRESS_IPI)       begin pending <= pending | wb_bits;          end
+                else if (wishbone.adr == ADDRESS_IPI_CLEAR) begin pending <= pending & ~wb_bits;         end
+                else if (wb_message_valid) begin
+                    messages[wb_message_index] <= (messages[wb_message_index] & ~wb_write_mask)
+                                                | (wb_dat_mosi & wb_write_mask);
+                end
+            end
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                         Wishbone                                         |
+    // --------------------------------------------------------------------------------------------
+
+    /*verilator lint_off UNUSED*/
+    logic [31:0] wb_dat_mosi;
+    assign       wb_dat_mosi = wishbone.dat_mosi;
+
+    logic wb_access;
+    assign wb_access = (wishbone.cyc && wishbone.stb && wishbone.ack == 0 && wishbone.err == 0) && // wb cycle
+                       (wishbone.adr >= ADDRESS && wishbone.adr < ADDRESS + SIZE); // wb address valid
+
+    logic [3:0]  wb_write_sel;
+    assign wb_write_sel = (wb_access && wishbone.we) ? wishbone.sel : 0;
+
+    logic [31:0] wb_write_mask;
+    assign wb_write_mask = {{8{wb_write_sel[3]}}, {8{wb_write_sel[2]}}, {8{wb_write_sel[1]}}, {8{wb_write_sel[0]}}};
+
+    logic [31:0] wb_message_offset;
+    assign wb_message_offset = wishbone.adr - ADDRESS_MESSAGES;
+
+    logic wb_message_valid;
+    assign wb_message_valid = wishbone.adr >= ADDRESS_MESSAGES && wb_message_offset < NUM_HARTS;
+
+    logic [2:0] wb_message_index;
+    assign wb_message_index = wb_message_offset[2:0];
+    /*verilator lint_on UNUSED*/
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            wishbone.ack      <= 0;
+            wishbone.err      <= 0;
+            wishbone.dat_miso <= 0;
+        end
+        else begin
+            // default output
+            wishbone.ack      <= 0;
+            wishbone.err      <= 0;
+            wishbone.dat_miso <= 0;
+            // wishbone access
+            if (wishbone.cyc && wishbone.stb && wishbone.ack == 0 && wishbone.err == 0) begin
+                // check address space
+                if (wishbone.adr >= ADDRESS && wishbone.adr < ADDRESS + SIZE) begin
+                    wishbone.ack <= 1;
+                    wishbone.err <= 0;
+                    if (wishbone.we == 0) begin
+                        // read
+                        if      (wishbone.adr == ADDRESS_HARTID)    begin wishbone.dat_miso <= 32'(hart);      end
+                        else if (wishbone.adr == ADDRESS_NUM_HARTS) begin wishbone.dat_miso <= 32'(NUM_HARTS); end
+                        else if (wishbone.adr == ADDRESS_RUN)       begin wishbone.dat_miso <= 32'(run_reg);   end
+                        else if (wishbone.adr == ADDRESS_IPI)       begin wishbone.dat_miso <= 32'(pending);   end
+                        else if (wb_message_valid) begin
+                            wishbone.dat_miso <= messages[wb_message_index];
+                        end
+                    end
+                end
+                else begin
+                    wishbone.ack <= 0;
+                    wishbone.err <= 1;
+                end
+            end
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                          Output                                          |
+    // --------------------------------------------------------------------------------------------
+
+    assign run = run_reg;
+    assign ipi = pending;
+
+endmodule
@@ -0,0 +1,223 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: wishbone_monitor.sv
+ */
+
+module wishbone_monitor #(
+    parameter bit [31:0] ADDRESS,
+    parameter bit [31:0] SIZE,
+    // Slave map of the observed interconnect (same encoding as wishbone_interconnect)
+    parameter int NUM_SLAVES,
+    parameter bit [32*NUM_SLAVES-1:0] SLAVE_ADDRESS,
+    parameter bit [32*NUM_SLAVES-1:0] SLAVE_SIZE,
+    // Hardware counters (0: register window reads 0, only the simulation trace is available)
+    parameter bit ENABLE = 1,
+    parameter int HISTOGRAM_BINS = 8
+) (
+    input logic clk,
+    input logic rst,
+
+    // Observed bus (master side of the interconnect)
+    wishbone_interface.monitor bus,
+
+    // Register window
+    wishbone_interface.slave wishbone
+);
+    /*
+    Wishbone bus monitor
+    Counts the transactions on the observed bus per slave of the interconnect and sorts their
+    latency (cycles from the first strobe to ack/err, 1 = single cycle) into a histogram with
+    bins 1, 2, 3-4, 5-8, ..., the last bin takes all longer transactions.
+    The following registers are provided:
+    - 0x00: Control register: bit 0: counting enabled (reset value 1), bit 1: clear all counters
+            (write only)
+    - 0x01: Info register: bits 7:0: number of slaves, bits 15:8: number of histogram bins
+            (0 if the counters are not synthesized)
+    - 0x02: Cycle counter (while enabled)
+    - 0x03: Busy counter (cycles with a transaction in flight, while enabled)
+    - 0x10 * (n + 1): Counters of slave n (in the order of SLAVE_ADDRESS, first is 0):
+            +0: reads, +1: writes, +2: errors, +3: sum of all latencies,
+            +4 ... +4 + HISTOGRAM_BINS - 1: latency histogram
+    In simulation, +bus_trace writes one record per transaction to bus_trace.bin
+    (see sim/bus_trace.py).
+    */
+
+    localparam int STRIDE = 16;
+    localparam int SLAVE_INDEX_BITS = $clog2(NUM_SLAVES + 1);
+
+    // --------------------------------------------------------------------------------------------
+    // |                                       Transactions                                       |
+    // --------------------------------------------------------------------------------------------
+
+    logic [15:0] latency;
+    logic        done;
+    logic [31:0] transaction_latency;
+    logic [SLAVE_INDEX_BITS-1:0] slave_index;
+    logic        slave_valid;
+
+    assign done = bus.cyc && bus.stb && (bus.ack || bus.err);
+    assign transaction_latency = 32'(latency) + 1;
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            latency <= 0;
+        end
+        else if (done || !(bus.cyc && bus.stb)) begin
+            latency <= 0;
+        end
+        else if (latency != '1) begin
+            latency <= latency + 1;
+        end
+    end
+
+    // Address decoding (first slave in SLAVE_ADDRESS has index 0)
+    always_comb begin
+        slave_index = 0;
+        slave_valid = 0;
+        for (int slave = 0; slave < NUM_SLAVES; slave++) begin
+            if (bus.adr >= SLAVE_ADDRESS[32 * (NUM_SLAVES - slave - 1) +: 32] &&
+                bus.adr <  SLAVE_ADDRESS[32 * (NUM_SLAVES - slave - 1) +: 32] + SLAVE_SIZE[32 * (NUM_SLAVES - slave - 1) +: 32]) begin
+                slave_index = SLAVE_INDEX_BITS'(slave);
+                slave_valid = 1;
+            end
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                         Counters                                         |
+    // --------------------------------------------------------------------------------------------
+
+    logic [31:0] offset;
+    assign offset = wishbone.adr - ADDRESS;
+
+    logic wishbone_sel;
+    assign wishbone_sel = wishbone.cyc && wishbone.stb && wishbone.adr >= ADDRESS && wishbone.adr < ADDRESS + SIZE;
+
+    if (ENABLE) begin: counters
+        logic        enable;
+        logic [31:0] cycles;
+        logic [31:0] busy;
+        logic [31:0] slave_counters [NUM_SLAVES][STRIDE];
+
+        logic clear;
+        assign clear = wishbone_sel && wishbone.we && offset == 0 && wishbone.dat_mosi[1];
+
+        // Histogram bin of the finished transaction
+        int bin;
+        always_comb begin
+            bin = HISTOGRAM_BINS - 1;
+            for (int i = HISTOGRAM_BINS - 2; i >= 0; i--) begin
+                if (transaction_latency <= (32'd1 << i)) begin
+                    bin = i;
+                end
+            end
+        end
+
+        always_ff @(posedge clk) begin
+            if (rst || clear) begin
+                cycles <= 0;
+                busy   <= 0;
+                for (int slave = 0; slave < NUM_SLAVES; slave++) begin
+                    for (int i = 0; i < STRIDE; i++) begin
+                        slave_counters[slave][i] <= 0;
+                    end
+                end
+            end
+            else if (enable) begin
+                cycles <= cycles + 1;
+                if (bus.cyc && bus.stb) begin
+                    busy <= busy + 1;
+                end
+                if (done && slave_valid) begin
+                    if (bus.err)     slave_counters[slave_index][2] <= slave_counters[slave_index][2] + 1;
+                    else if (bus.we) slave_counters[slave_index][1] <= slave_counters[slave_index][1] + 1;
+                    else             slave_counters[slave_index][0] <= slave_counters[slave_index][0] + 1;
+                    slave_counters[slave_index][3]       <= slave_counters[slave_index][3] + transaction_latency;
+                    slave_counters[slave_index][4 + bin] <= slave_counters[slave_index][4 + bin] + 1;
+                end
+            end
+        end
+
+        always_ff @(posedge clk) begin
+            if (rst) begin
+                enable <= 1;
+            end
+            else if (wishbone_sel && wishbone.we && offset == 0) begin
+                enable <= wishbone.dat_mosi[0];
+            end
+        end
+
+        // Register window
+        always_ff @(posedge clk) begin
+            if (rst) begin
+                wishbone.ack      <= 0;
+                wishbone.dat_miso <= 0;
+            end
+            else begin
+                wishbone.ack      <= wishbone_sel && !wishbone.ack;
+                wishbone.dat_miso <= 0;
+                if (wishbone_sel && !wishbone.ack && !wishbone.we) begin
+                    if      (offset == 0) begin wishbone.dat_miso <= 32'(enable); end
+                    else if (offset == 1) begin wishbone.dat_miso <= {16'b0, 8'(HISTOGRAM_BINS), 8'(NUM_SLAVES)}; end
+                    else if (offset == 2) begin wishbone.dat_miso <= cycles; end
+                    else if (offset == 3) begin wishbone.dat_miso <= busy; end
+                    else if (offset >= STRIDE && offset < STRIDE * (NUM_SLAVES + 1) && offset % STRIDE < 4 + HISTOGRAM_BINS) begin
+                        wishbone.dat_miso <= slave_counters[offset / STRIDE - 1][offset % STRIDE];
+                    end
+                end
+            end
+        end
+    end
+    else begin: no_counters
+        // Window is still decoded, all registers read 0
+        always_ff @(posedge clk) begin
+            if (rst) begin
+                wishbone.ack <= 0;
+            end
+            else begin
+                wishbone.ack <= wishbone_sel && !wishbone.ack;
+            end
+        end
+        assign wishbone.dat_miso = 0;
+    end
+
+    assign wishbone.err = 0;
+
+    // --------------------------------------------------------------------------------------------
+    // |                                     Simulation trace                                     |
+    // --------------------------------------------------------------------------------------------
+
+    `ifndef SYNTHESIS
+    // Record (3 words, written with %u): cycle, byte address,
+    // {latency[15:0], flags[7:0] (bit 0: write, bit 1: error), slave[7:0] (0xff: unmapped)}
+    // The file starts with the magic word "HDBT", which also tells the byte order.
+    int          trace_file = 0;
+    logic [31:0] trace_cycle = 0;
+
+    initial begin
+        if ($test$plusargs("bus_trace")) begin
+            trace_file = $fopen("bus_trace.bin", "wb");
+            $fwrite(trace_file, "%u", 32'h48_44_42_54);
+        end
+    end
+
+    always @(posedge clk) begin
+        trace_cycle <= trace_cycle + 1;
+        if (trace_file != 0 && !rst && done) begin
+            $fwrite(trace_file, "%u%u%u",
+                trace_cycle - 32'(latency),
+                {bus.adr[29:0], 2'b00},
+                {latency + 16'd1, 6'b0, bus.err, bus.we, slave_valid ? 8'(slave_index) : 8'hff});
+        end
+    end
+
+    final begin
+        if (trace_file != 0) begin
+            $fclose(trace_file);
+        end
+    end
+    `endif
+
+endmodule
@@ -15,9 +15,22 @@
 // | If you're looking for examples on how to implement a Wishbone slave, look elsewhere.       |
 // ----------------------------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------------------------
+// |                                                                                            |
+// | The memory can be split into NUM_BANKS word-interleaved banks (bank = word offset modulo   |
+// | NUM_BANKS). Every bank is an independent dual port memory with its own read registers,     |
+// | i.e. Vivado maps each bank to its own column of BRAMs instead of one deep cascade.         |
+// | Sequential fetches and data accesses to neighbouring words end up in different banks.      |
+// | NUM_BANKS must be a power of two and SIZE a multiple of NUM_BANKS.                         |
+// |                                                                                            |
+// ----------------------------------------------------------------------------------------------
+
 module wishbone_ram #(
     parameter bit [31:0] ADDRESS,
-    parameter bit [31:0] SIZE
+    parameter bit [31:0] SIZE,
+    parameter int        NUM_BANKS = 1,
+    // Load the program (init.mem) at startup, 0 leaves the memory uninitialized
+    parameter bit        INIT = 1
 )(
     input logic clk,
     input logic rst,
@@ -26,47 +39,124 @@ module wishbone_ram #(
     wishbone_interface.slave port_b
 );
 
+    localparam bit [31:0] BANK_SIZE = SIZE / NUM_BANKS;
+
+    // --------------------------------------------------------------------------------------------
+    // |                                     Address Decoding                                     |
+    // --------------------------------------------------------------------------------------------
+
+    logic [31:0] port_a_offset, port_b_offset;
+    logic [31:0] port_a_bank,   port_b_bank;
+    logic [31:0] port_a_row,    port_b_row;
+    logic        port_a_valid,  port_b_valid;
+
+    assign port_a_offset = port_a.adr - ADDRESS;
+    assign port_a_bank   = port_a_offset % NUM_BANKS;
+    assign port_a_row    = port_a_offset / NUM_BANKS;
+    assign port_a_valid  = port_a.adr >= ADDRESS && port_a.adr < ADDRESS + SIZE;
+
+    assign port_b_offset = port_b.adr - ADDRESS;
+    assign port_b_bank   = port_b_offset % NUM_BANKS;
+    assign port_b_row    = port_b_offset / NUM_BANKS;
+    assign port_b_valid  = port_b.adr >= ADDRESS && port_b.adr < ADDRESS + SIZE;
+
     // --------------------------------------------------------------------------------------------
     // |                                          Memory                                          |
     // --------------------------------------------------------------------------------------------
 
-    // Note: ram_decomp attribute ensures Vivado specifies as a Byte Wide Write Enable RAM
-    (* ram_decomp = "power" *)
-    logic [31:0] memory [SIZE];
+    logic [31:0] port_a_bank_dat [NUM_BANKS];
+    logic [31:0] port_b_bank_dat [NUM_BANKS];
+
+    for (genvar bank = 0; bank < NUM_BANKS; bank++) begin: banks
+        // Note: ram_decomp attribute ensures Vivado specifies as a Byte Wide Write Enable RAM
+        (* ram_decomp = "power" *)
+        logic [31:0] memory [BANK_SIZE];
+
+        if (!INIT) begin: no_init
+        end
+        else if (NUM_BANKS == 1) begin: init
+            initial $readmemh("init.mem", memory);
+        end
+        else begin: init_interleaved
+            // Distribute the (linear) memory file over the banks
+            logic [31:0] init_memory [SIZE];
+            initial begin
+                $readmemh("init.mem", init_memory);
+                for (int row = 0; row < BANK_SIZE; row++) begin
+                    memory[row] = init_memory[row * NUM_BANKS + bank];
+                end
+            end
+        end
 
-    initial $readmemh("init.mem", memory);
+        logic [31:0] port_a_dat, port_b_dat;
+        assign port_a_bank_dat[bank] = port_a_dat;
+        assign port_b_bank_dat[bank] = port_b_dat;
+
+        logic port_a_select, port_b_select;
+        assign port_a_select = port_a.cyc && port_a.stb && port_a_valid && port_a_bank == bank;
+        assign port_b_select = port_b.cyc && port_b.stb && port_b_valid && port_b_bank == bank;
+
+        // Port A
+        always_ff @(posedge clk) begin
+            if (port_a_select) begin
+                if (port_a.we == 0) begin
+                    // read
+                    port_a_dat <= memory[port_a_row];
+                end
+                else begin
+                    // write
+                    if (port_a.sel[0] == 1) begin memory[port_a_row][ 7: 0] <= port_a.dat_mosi[ 7: 0]; end
+                    if (port_a.sel[1] == 1) begin memory[port_a_row][15: 8] <= port_a.dat_mosi[15: 8]; end
+                    if (port_a.sel[2] == 1) begin memory[port_a_row][23:16] <= port_a.dat_mosi[23:16]; end
+                    if (port_a.sel[3] == 1) begin memory[port_a_row][31:24] <= port_a.dat_mosi[31:24]; end
+                end
+            end
+        end
+
+        // Port B
+        always_ff @(posedge clk) begin
+            if (port_b_select) begin
+                if (port_b.we == 0) begin
+                    // read
+                    port_b_dat <= memory[port_b_row];
+                end
+                else begin
+                    // write
+                    if (port_b.sel[0] == 1) begin memory[port_b_row][ 7: 0] <= port_b.dat_mosi[ 7: 0]; end
+                    if (port_b.sel[1] == 1) begin memory[port_b_row][15: 8] <= port_b.dat_mosi[15: 8]; end
+                    if (port_b.sel[2] == 1) begin memory[port_b_row][23:16] <= port_b.dat_mosi[23:16]; end
+                    if (port_b.sel[3] == 1) begin memory[port_b_row][31:24] <= port_b.dat_mosi[31:24]; end
+                end
+            end
+        end
+    end
 
     // --------------------------------------------------------------------------------------------
     // |                                          Port A                                          |
     // --------------------------------------------------------------------------------------------
+    logic        port_a_read;
+    logic [31:0] port_a_read_bank;
+
     always_ff @(posedge clk) begin
         if (rst) begin
-            port_a.ack      <= 0;
-            port_a.err      <= 0;
-            port_a.dat_miso <= 0;
+            port_a.ack       <= 0;
+            port_a.err       <= 0;
+            port_a_read      <= 0;
+            port_a_read_bank <= 0;
         end
         else begin
             // default output
-            port_a.ack      <= 0;
-            port_a.err      <= 0;
-            port_a.dat_miso <= 0;
+            port_a.ack  <= 0;
+            port_a.err  <= 0;
+            port_a_read <= 0;
             // wishbone access
             if (port_a.cyc && port_a.stb) begin
                 // check address space
-                if (port_a.adr >= ADDRESS && port_a.adr < ADDRESS + SIZE) begin
-                    port_a.ack <= 1;
-                    port_a.err <= 0;
-                    if (port_a.we == 0) begin
-                        // read
-                        port_a.dat_miso <= memory[port_a.adr - ADDRESS];
-                    end
-                    else begin
-                        // write
-                        if (port_a.sel[0] == 1) begin memory[port_a.adr - ADDRESS][ 7: 0] <= port_a.dat_mosi[ 7: 0]; end
-                        if (port_a.sel[1] == 1) begin memory[port_a.adr - ADDRESS][15: 8] <= port_a.dat_mosi[15: 8]; end
-                        if (port_a.sel[2] == 1) begin memory[port_a.adr - ADDRESS][23:16] <= port_a.dat_mosi[23:16]; end
-                        if (port_a.sel[3] == 1) begin memory[port_a.adr - ADDRESS][31:24] <= port_a.dat_mosi[31:24]; end
-                    end
+                if (port_a_valid) begin
+                    port_a.ack       <= 1;
+                    port_a.err       <= 0;
+                    port_a_read      <= port_a.we == 0;
+                    port_a_read_bank <= port_a_bank;
                 end
                 else begin
                     port_a.ack <= 0;
@@ -76,37 +166,34 @@ module wishbone_ram #(
         end
     end
 
+    assign port_a.dat_miso = port_a_read ? port_a_bank_dat[port_a_read_bank] : 0;
+
     // --------------------------------------------------------------------------------------------
     // |                                          Port B                                          |
     // --------------------------------------------------------------------------------------------
+    logic        port_b_read;
+    logic [31:0] port_b_read_bank;
+
     always_ff @(posedge clk) begin
         if (rst) begin
-            port_b.ack      <= 0;
-            port_b.err      <= 0;
-            port_b.dat_miso <= 0;
+            port_b.ack       <= 0;
+            port_b.err       <= 0;
+            port_b_read      <= 0;
+            port_b_read_bank <= 0;
         end
         else begin
             // default output
-            port_b.ack      <= 0;
-            port_b.err      <= 0;
-            port_b.dat_miso <= 0;
+            port_b.ack  <= 0;
+            port_b.err  <= 0;
+            port_b_read <= 0;
             // wishbone access
             if (port_b.cyc && port_b.stb) begin
                 // check address space
-                if (port_b.adr >= ADDRESS && port_b.adr < ADDRESS + SIZE) begin
-                    port_b.ack <= 1;
-                    port_b.err <= 0;
-                    if (port_b.we == 0) begin
-                        // read
-                        port_b.dat_miso <= memory[port_b.adr - ADDRESS];
-                    end
-                    else begin
-                        // write
-                        if (port_b.sel[0] == 1) begin memory[port_b.adr - ADDRESS][ 7: 0] <= port_b.dat_mosi[ 7: 0]; end
-                        if (port_b.sel[1] == 1) begin memory[port_b.adr - ADDRESS][15: 8] <= port_b.dat_mosi[15: 8]; end
-                        if (port_b.sel[2] == 1) begin memory[port_b.adr - ADDRESS][23:16] <= port_b.dat_mosi[23:16]; end
-                        if (port_b.sel[3] == 1) begin memory[port_b.adr - ADDRESS][31:24] <= port_b.dat_mosi[31:24]; end
-                    end
+                if (port_b_valid) begin
+                    port_b.ack       <= 1;
+                    port_b.err       <= 0;
+                    port_b_read      <= port_b.we == 0;
+                    port_b_read_bank <= port_b_bank;
                 end
                 else begin
                     port_b.ack <= 0;
@@ -116,4 +203,6 @@ module wishbone_ram #(
         end
     end
 
+    assign port_b.dat_miso = port_b_read ? port_b_bank_dat[port_b_read_bank] : 0;
+
 endmodule
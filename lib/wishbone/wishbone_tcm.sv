@@ -0,0 +1,105 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: wishbone_tcm.sv
+ */
+
+
+
+// ----------------------------------------------------------------------------------------------
+// |                                          WARNING                                           |
+// |                                                                                            |
+// | Like wishbone_ram, this module uses an inverted clk signal to achieve single cycle         |
+// | performance. This should *not* be replicated in any other module.                          |
+// ----------------------------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Tightly coupled data memory (TCM).                                                           |
+// | Sits directly at the memory port of the CPU, in front of the peripheral interconnect.        |
+// | Accesses to [ADDRESS, ADDRESS + SIZE) are answered by a local memory within the same cycle,  |
+// | all other accesses are passed through to the bus unchanged.                                  |
+// | The TCM is not reachable from the fetch port, code can't be executed from it.                |
+// | SIZE = 0 disables the TCM (pure pass-through).                                               |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module wishbone_tcm #(
+    parameter bit [31:0] ADDRESS,
+    parameter bit [31:0] SIZE
+)(
+    input logic clk,
+    input logic rst,
+
+    wishbone_interface.slave  cpu,
+    wishbone_interface.master bus
+);
+
+    logic hit;
+
+    logic        tcm_ack;
+    logic [31:0] tcm_dat_miso;
+
+    // --------------------------------------------------------------------------------------------
+    // |                                          Memory                                          |
+    // --------------------------------------------------------------------------------------------
+
+    if (SIZE > 0) begin: tcm
+        assign hit = cpu.adr >= ADDRESS && cpu.adr < ADDRESS + SIZE;
+
+        // Note: ram_decomp attribute ensures Vivado specifies as a Byte Wide Write Enable RAM
+        (* ram_decomp = "power" *)
+        logic [31:0] memory [SIZE];
+
+        always_ff @(posedge clk) begin
+            if (rst) begin
+                tcm_ack      <= 0;
+                tcm_dat_miso <= 0;
+            end
+            else begin
+                // default output
+                tcm_ack      <= 0;
+                tcm_dat_miso <= 0;
+                // local access
+                if (cpu.cyc && cpu.stb && hit) begin
+                    tcm_ack <= 1;
+                    if (cpu.we == 0) begin
+                        // read
+                        tcm_dat_miso <= memory[cpu.adr - ADDRESS];
+                    end
+                    else begin
+                        // write
+                        if (cpu.sel[0] == 1) begin memory[cpu.adr - ADDRESS][ 7: 0] <= cpu.dat_mosi[ 7: 0]; end
+                        if (cpu.sel[1] == 1) begin memory[cpu.adr - ADDRESS][15: 8] <= cpu.dat_mosi[15: 8]; end
+                        if (cpu.sel[2] == 1) begin memory[cpu.adr - ADDRESS][23:16] <= cpu.dat_mosi[23:16]; end
+                        if (cpu.sel[3] == 1) begin memory[cpu.adr - ADDRESS][31:24] <= cpu.dat_mosi[31:24]; end
+                    end
+                end
+            end
+        end
+    end
+    else begin: no_tcm
+        assign hit          = 0;
+        assign tcm_ack      = 0;
+        assign tcm_dat_miso = 0;
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                         Routing                                          |
+    // --------------------------------------------------------------------------------------------
+
+    // CPU -> bus (TCM accesses never start a bus cycle)
+    assign bus.cyc      = cpu.cyc && !hit;
+    assign bus.stb      = cpu.stb && !hit;
+    assign bus.adr      = cpu.adr;
+    assign bus.sel      = cpu.sel;
+    assign bus.we       = cpu.we;
+    assign bus.dat_mosi = cpu.dat_mosi;
+
+    // TCM / bus -> CPU
+    assign cpu.ack      = hit ? tcm_ack      : bus.ack;
+    assign cpu.err      = hit ? 0            : bus.err;
+    assign cpu.dat_miso = hit ? tcm_dat_miso : bus.dat_miso;
+
+endmodule
@@ -9,7 +9,7 @@
 
 module wishbone_test #(
     parameter bit [31:0] ADDRESS,
-    parameter bit [31:0] SIZE = 5
+    parameter bit [31:0] SIZE = 7
 ) (
     input logic clk,
     input logic rst,
@@ -29,6 +29,10 @@ module wishbone_test #(
     - 0x02: Counter register: Reads return an incrementing number, starting at 0
     - 0x03: Stall Acknowledge register: Reading and writing stall for 3 clock cycles before acknowledging
     - 0x04: Stall Error register: Reading and writing stall for 3 clock cycles before erroring
+    - 0x05: Report key register: Name of the next reported value (up to 4 ASCII characters,
+            first character in the lowest byte)
+    - 0x06: Report value register: Write to send the key/value pair to the testbench
+            (used by the benchmarks to report cycles, instructions, ...)
     */
 
 
@@ -137,6 +141,35 @@ module wishbone_test #(
         end
     end
 
+    // Report registers
+
+    logic [31:0] report_key;
+    logic [31:0] report_value;
+    logic report_stb;
+    logic report_key_sel, report_key_ack, report_value_sel, report_value_ack;
+    assign report_key_sel   = wishbone.cyc && wishbone.stb && offset == 5;
+    assign report_key_ack   = report_key_sel;
+    assign report_value_sel = wishbone.cyc && wishbone.stb && offset == 6;
+    assign report_value_ack = report_value_sel;
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            report_key   <= 0;
+            report_value <= 0;
+            report_stb   <= 0;
+        end
+        else begin
+            report_stb <= 0;
+            if (report_key_ack && wishbone.we) begin
+                report_key <= wishbone.dat_mosi;
+            end
+            if (report_value_ack && wishbone.we) begin
+                report_value <= wishbone.dat_mosi;
+                report_stb   <= 1;
+            end
+        end
+    end
+
     // --------------------------------------------------------------------------------------------
     // |                                         Wishbone                                         |
     // --------------------------------------------------------------------------------------------
@@ -147,18 +180,22 @@ module wishbone_test #(
         interrupt_sel,
         counter_sel,
         stall_sel,
-        error_sel
+        error_sel,
+        report_key_sel,
+        report_value_sel
     };
 
     assign wishbone.ack = |{
         test_ack,
         interrupt_ack,
         counter_ack,
-        stall_ack
+        stall_ack,
+        report_key_ack,
+        report_value_ack
     };
 
     assign wishbone.err = |{
-        wishbone.adr >= ADDRESS && wishbone.adr < ADDRESS + SIZE && !wishbone_sel,
+        wishbone.cyc && wishbone.stb && wishbone.adr >= ADDRESS && wishbone.adr < ADDRESS + SIZE && !wishbone_sel,
         error_err
     };
 
@@ -166,5 +203,7 @@ module wishbone_test #(
         interrupt_ack ? interrupt_counter :
         counter_ack ? counter :
         stall_ack ? stall_reg :
+        report_key_ack ? report_key :
+        report_value_ack ? report_value :
         32'b0;
 endmodule
@@ -9,14 +9,22 @@
 
 module wishbone_timer #(
     parameter bit [31:0] ADDRESS,
-    parameter bit [31:0] SIZE = 5,
-    parameter bit [31:0] CLK_FREQUENCY_MHZ
+    parameter int        NUM_CHANNELS = 4,
+    parameter bit [31:0] SIZE = 9 + 4 * NUM_CHANNELS,
+    parameter bit [31:0] CLK_FREQUENCY_MHZ,
+    parameter int        NUM_HARTS = 1
 ) (
     input logic clk,
     input logic rst,
 
+    // Hart of the current bus transaction (see wishbone_arbiter grant), selects the mtimeh latch
+    input logic [2:0] hart,
+
     output logic interrupt,
 
+    // Output compare / PWM pins (one per channel)
+    output logic [NUM_CHANNELS-1:0] pwm,
+
     wishbone_interface.slave wishbone
 );
 
@@ -76,22 +84,75 @@ module wishbone_timer #(
     // ADDRESS+2: mtimeh
     // ADDRESS+3: mtimecmp
     // ADDRESS+4: mtimecmph
+    // ADDRESS+5: mtime control (periodic mode)
+    // ADDRESS+6: mtime reload period
+    // ADDRESS+7: interrupt pending (write 1 to clear)
+    // ADDRESS+8+4*n: channel n control
+    // ADDRESS+9+4*n: channel n period
+    // ADDRESS+10+4*n: channel n compare
+    // ADDRESS+11+4*n: channel n counter
+    // ADDRESS+8+4*NUM_CHANNELS: mtimeh latched by the last read of mtime of the reading hart
     localparam ADDRESS_MTIMESTATUS = (ADDRESS+0);
     localparam ADDRESS_MTIME       = (ADDRESS+1);
     localparam ADDRESS_MTIMEH      = (ADDRESS+2);
     localparam ADDRESS_MTIMECMP    = (ADDRESS+3);
     localparam ADDRESS_MTIMECMPH   = (ADDRESS+4);
+    localparam ADDRESS_MTIMECTRL   = (ADDRESS+5);
+    localparam ADDRESS_MTIMEPERIOD = (ADDRESS+6);
+    localparam ADDRESS_PENDING     = (ADDRESS+7);
+    localparam ADDRESS_CHANNELS    = (ADDRESS+8);
+    localparam ADDRESS_MTIMEH_LATCHED = (ADDRESS_CHANNELS + 4 * NUM_CHANNELS);
+
+    localparam CHANNEL_CTRL    = 0;
+    localparam CHANNEL_PERIOD  = 1;
+    localparam CHANNEL_COMPARE = 2;
+    localparam CHANNEL_COUNTER = 3;
+
+    localparam CHANNEL_INDEX_WIDTH = (NUM_CHANNELS > 1) ? $clog2(NUM_CHANNELS) : 1;
 
     // --------------------------------- TIMER CONTROL AND STATUS ---------------------------------
     /*
-    <------------------------------------> <- NS_PER_CYCLE ->
-    | 31....24 ||| 23....16 ||| 15.....8 |||     8....0     |
-    | 31----24 ||| 23----16 ||| 15-----8 |||  8----------0  |
-    | xxxxxxxx ||| xxxxxxxx ||| xxxxxxxx |||  NS_PER_CYCLE  |
+    <------------------------> <- NUM_CHANNELS -> <- NS_PER_CYCLE ->
+    | 31....24 ||| 23....16 |||     15.....8     |||     7....0     |
+    | 31----24 ||| 23----16 |||     15-----8     |||  7----------0  |
+    | xxxxxxxx ||| xxxxxxxx |||   NUM_CHANNELS   |||  NS_PER_CYCLE  |
     */
     logic [31:0] mtime_status;
-    assign mtime_status = {24'b0, 8'(1000/CLK_FREQUENCY_MHZ)};
+    assign mtime_status = {16'b0, 8'(NUM_CHANNELS), 8'(1000/CLK_FREQUENCY_MHZ)};
+
+    // --------------------------------------- MTIME CONTROL --------------------------------------
+    /*
+    | 31-------------------------1 |     0    |
+    | xxxxxxxxxxxxxxxxxxxxxxxxxxxx | PERIODIC |
+
+    PERIODIC: When mtime reaches mtimecmp, mtimecmp is advanced by the reload period and the
+              mtime pending bit is set. The timer interrupt then follows the pending bit instead
+              of mtime >= mtimecmp, so re-arming only needs a single write to the pending register.
+    */
+    localparam MTIMECTRL_PERIODIC_IDX = 0;
+
+    logic [31:0] mtime_ctrl;
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            mtime_ctrl <= 0;
+        end
+        else if (wb_write_sel != 0 && wishbone.adr == ADDRESS_MTIMECTRL) begin
+            mtime_ctrl <= (mtime_ctrl & ~wb_write_mask) | (wb_dat_mosi & wb_write_mask);
+        end
+    end
+
+    logic mtime_periodic;
+    assign mtime_periodic = mtime_ctrl[MTIMECTRL_PERIODIC_IDX];
 
+    logic [31:0] mtime_period;
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            mtime_period <= 0;
+        end
+        else if (wb_write_sel != 0 && wishbone.adr == ADDRESS_MTIMEPERIOD) begin
+            mtime_period <= (mtime_period & ~wb_write_mask) | (wb_dat_mosi & wb_write_mask);
+        end
+    end
 
     // ------------------------------------------- MTIME ------------------------------------------
     logic [63:0] mtime;
@@ -118,13 +179,39 @@ module wishbone_timer #(
         end
     end
 
+    // Reading mtime latches the upper half for the reading hart, a following read of the latched
+    // register returns the upper half from the same cycle (64 bit read without retry loop).
+    // mtimeh itself is always live (hi-lo-hi reads work as well).
+    logic [31:0] mtimeh_latched [NUM_HARTS];
+
+    logic [2:0] latch_index;
+    assign latch_index = (32'(hart) < NUM_HARTS) ? hart : 0;
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            for (int i = 0; i < NUM_HARTS; i++) begin
+                mtimeh_latched[i] <= 0;
+            end
+        end
+        else if (wb_read && wishbone.adr == ADDRESS_MTIME) begin
+            mtimeh_latched[latch_index] <= mtime[63:32];
+        end
+    end
+
     // ----------------------------------------- MTIMECMP -----------------------------------------
     logic [63:0] mtimecmp;
+    logic        mtime_match;
+    assign mtime_match = (mtime >= mtimecmp);
+
     always_ff @(posedge clk) begin
         if (rst) begin
             mtimecmp <= 0;
         end
         else begin
+            // periodic mode: advance compare value by one period (no drift, no cpu involvement)
+            if (mtime_periodic && mtime_match) begin
+                mtimecmp <= mtimecmp + 64'(mtime_period);
+            end
             // handle write access to register
             if (wishbone.adr == ADDRESS_MTIMECMP) begin
                 if (wb_write_sel[0] == 1) begin mtimecmp[ 7: 0] <= wb_dat_mosi[ 7: 0]; end
@@ -141,6 +228,151 @@ module wishbone_timer #(
         end
     end
 
+    // ----------------------------------------- CHANNELS -----------------------------------------
+    /*
+    Channel control register:
+    | 31-------------6 |   5...4    |    3    |     2      |     1     |   0    |
+    | xxxxxxxxxxxxxxxx | OUTPUT_MODE | ONESHOT | COMPARE_IE | RELOAD_IE | ENABLE |
+
+    Each channel has its own 32 bit counter which runs from 0 to PERIOD-1 and then reloads
+    itself in hardware (PERIOD = 0 wraps after 2^32 cycles). ONESHOT clears ENABLE on reload.
+    A reload sets the channel's reload pending bit, counter == COMPARE sets its compare
+    pending bit. Pending bits only raise the interrupt if the matching *_IE bit is set.
+
+    OUTPUT_MODE: 0 = low, 1 = PWM (high while counter < COMPARE), 2 = toggle on compare, 3 = high
+    */
+    localparam CHANNEL_ENABLE_IDX     = 0;
+    localparam CHANNEL_RELOAD_IE_IDX  = 1;
+    localparam CHANNEL_COMPARE_IE_IDX = 2;
+    localparam CHANNEL_ONESHOT_IDX    = 3;
+    localparam CHANNEL_OUTPUT_IDX     = 4;
+
+    localparam OUTPUT_LOW    = 2'd0;
+    localparam OUTPUT_PWM    = 2'd1;
+    localparam OUTPUT_TOGGLE = 2'd2;
+    localparam OUTPUT_HIGH   = 2'd3;
+
+    logic [NUM_CHANNELS-1:0] [3:0] [31:0] channel_registers;
+    logic [NUM_CHANNELS-1:0]              channel_reload;
+    logic [NUM_CHANNELS-1:0]              channel_compare;
+    logic [NUM_CHANNELS-1:0]              channel_reload_ie;
+    logic [NUM_CHANNELS-1:0]              channel_compare_ie;
+
+    for (genvar n = 0; n < NUM_CHANNELS; n++) begin: channel
+        localparam bit [31:0] ADDRESS_CTRL    = ADDRESS_CHANNELS + 4 * n + CHANNEL_CTRL;
+        localparam bit [31:0] ADDRESS_PERIOD  = ADDRESS_CHANNELS + 4 * n + CHANNEL_PERIOD;
+        localparam bit [31:0] ADDRESS_COMPARE = ADDRESS_CHANNELS + 4 * n + CHANNEL_COMPARE;
+        localparam bit [31:0] ADDRESS_COUNTER = ADDRESS_CHANNELS + 4 * n + CHANNEL_COUNTER;
+
+        logic [31:0] ctrl;
+        logic [31:0] period;
+        logic [31:0] compare;
+        logic [31:0] counter;
+
+        logic       enable;
+        logic [1:0] output_mode;
+        assign enable      = ctrl[CHANNEL_ENABLE_IDX];
+        assign output_mode = ctrl[CHANNEL_OUTPUT_IDX +: 2];
+
+        assign channel_reload[n]     = enable && (counter >= period - 1);
+        assign channel_compare[n]    = enable && (counter == compare);
+        assign channel_reload_ie[n]  = ctrl[CHANNEL_RELOAD_IE_IDX];
+        assign channel_compare_ie[n] = ctrl[CHANNEL_COMPARE_IE_IDX];
+
+        always_ff @(posedge clk) begin
+            if (rst) begin
+                ctrl    <= 0;
+                period  <= 0;
+                compare <= 0;
+                counter <= 0;
+            end
+            else begin
+                // count and reload
+                if (channel_reload[n]) begin
+                    counter <= 0;
+                    if (ctrl[CHANNEL_ONESHOT_IDX]) begin
+                        ctrl[CHANNEL_ENABLE_IDX] <= 0;
+                    end
+                end
+                else if (enable) begin
+                    counter <= counter + 1;
+                end
+                // handle write access to registers (has priority over counting and reload)
+                if (wb_write_sel != 0 && wishbone.adr == ADDRESS_CTRL) begin
+                    ctrl <= (ctrl & ~wb_write_mask) | (wb_dat_mosi & wb_write_mask);
+                end
+                if (wb_write_sel != 0 && wishbone.adr == ADDRESS_PERIOD) begin
+                    period <= (period & ~wb_write_mask) | (wb_dat_mosi & wb_write_mask);
+                end
+                if (wb_write_sel != 0 && wishbone.adr == ADDRESS_COMPARE) begin
+                    compare <= (compare & ~wb_write_mask) | (wb_dat_mosi & wb_write_mask);
+                end
+                if (wb_write_sel != 0 && wishbone.adr == ADDRESS_COUNTER) begin
+                    counter <= (counter & ~wb_write_mask) | (wb_dat_mosi & wb_write_mask);
+                end
+            end
+        end
+
+        assign channel_registers[n][CHANNEL_CTRL]    = ctrl;
+        assign channel_registers[n][CHANNEL_PERIOD]  = period;
+        assign channel_registers[n][CHANNEL_COMPARE] = compare;
+        assign channel_registers[n][CHANNEL_COUNTER] = counter;
+
+        // output compare / pwm pin (registered to keep it glitch free)
+        logic out;
+        always_ff @(posedge clk) begin
+            if (rst) begin
+                out <= 0;
+            end
+            else begin
+                case (output_mode)
+                    OUTPUT_LOW:    out <= 0;
+                    OUTPUT_PWM:    out <= enable && (counter < compare);
+                    OUTPUT_TOGGLE: if (channel_compare[n]) out <= ~out;
+                    OUTPUT_HIGH:   out <= 1;
+                    default:       out <= 0;
+                endcase
+            end
+        end
+
+        assign pwm[n] = out;
+    end
+
+    // ------------------------------------- INTERRUPT PENDING ------------------------------------
+    /*
+    | 31--(2*NUM_CHANNELS+1) | ... | 2*n+2     | 2*n+1    | ... |   0   |
+    | xxxxxxxxxxxxxxxxxxxxxx | ... | COMPARE_n | RELOAD_n | ... | MTIME |
+
+    Bits are set by hardware and cleared by writing 1.
+    */
+    localparam PENDING_WIDTH = 2 * NUM_CHANNELS + 1;
+
+    logic [PENDING_WIDTH-1:0] pending;
+    logic [PENDING_WIDTH-1:0] pending_set;
+    logic [PENDING_WIDTH-1:0] pending_clear;
+    logic [PENDING_WIDTH-1:0] pending_enable;
+
+    assign pending_set[0]    = mtime_match;
+    assign pending_enable[0] = 0; // mtime interrupt is handled separately below
+    for (genvar n = 0; n < NUM_CHANNELS; n++) begin: pending_bits
+        assign pending_set[2 * n + 1]    = channel_reload[n];
+        assign pending_set[2 * n + 2]    = channel_compare[n];
+        assign pending_enable[2 * n + 1] = channel_reload_ie[n];
+        assign pending_enable[2 * n + 2] = channel_compare_ie[n];
+    end
+
+    assign pending_clear = (wishbone.adr == ADDRESS_PENDING) ? PENDING_WIDTH'(wb_dat_mosi & wb_write_mask) : 0;
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            pending <= 0;
+        end
+        else begin
+            // a new event wins against a simultaneous clear
+            pending <= (pending & ~pending_clear) | pending_set;
+        end
+    end
+
     // --------------------------------------------------------------------------------------------
     // |                                         Wishbone                                         |
     // --------------------------------------------------------------------------------------------
@@ -153,8 +385,20 @@ module wishbone_timer #(
     assign wb_access = (wishbone.cyc && wishbone.stb && wishbone.ack == 0 && wishbone.err == 0) && // wb cycle
                        (wishbone.adr >= ADDRESS && wishbone.adr < ADDRESS + SIZE); // wb address valid
 
+    logic wb_read;
+    assign wb_read = wb_access && !wishbone.we;
+
     logic [3:0]  wb_write_sel;
     assign wb_write_sel = (wb_access && wishbone.we) ? wishbone.sel : 0;
+
+    logic [31:0] wb_write_mask;
+    assign wb_write_mask = {{8{wb_write_sel[3]}}, {8{wb_write_sel[2]}}, {8{wb_write_sel[1]}}, {8{wb_write_sel[0]}}};
+
+    logic [31:0] wb_channel_offset;
+    assign wb_channel_offset = wishbone.adr - ADDRESS_CHANNELS;
+
+    logic [CHANNEL_INDEX_WIDTH-1:0] wb_channel_index;
+    assign wb_channel_index = wb_channel_offset[2 +: CHANNEL_INDEX_WIDTH];
     /*verilator lint_on UNUSED*/
 
     always_ff @(posedge clk) begin
@@ -181,7 +425,13 @@ module wishbone_timer #(
                         else if (wishbone.adr == ADDRESS_MTIMEH)      begin wishbone.dat_miso <= mtime[63:32]; end
                         else if (wishbone.adr == ADDRESS_MTIMECMP)    begin wishbone.dat_miso <= mtimecmp[31: 0]; end
                         else if (wishbone.adr == ADDRESS_MTIMECMPH)   begin wishbone.dat_miso <= mtimecmp[63:32]; end
-                        else                                          begin wishbone.dat_miso <= 0; end // can not happen because of previous address check
+                        else if (wishbone.adr == ADDRESS_MTIMECTRL)   begin wishbone.dat_miso <= mtime_ctrl; end
+                        else if (wishbone.adr == ADDRESS_MTIMEPERIOD) begin wishbone.dat_miso <= mtime_period; end
+                        else if (wishbone.adr == ADDRESS_PENDING)     begin wishbone.dat_miso <= 32'(pending); end
+                        else if (wishbone.adr == ADDRESS_MTIMEH_LATCHED) begin wishbone.dat_miso <= mtimeh_latched[latch_index]; end
+                        else begin
+                            wishbone.dat_miso <= channel_registers[wb_channel_index][wb_channel_offset[1:0]];
+                        end
                     end
                 end
                 else begin
@@ -196,6 +446,11 @@ module wishbone_timer #(
     // |                                          Output                                          |
     // --------------------------------------------------------------------------------------------
 
-    assign interrupt = (mtime >= mtimecmp);
+    // In periodic mode the interrupt is held by the pending bit until software clears it,
+    // otherwise it follows mtime >= mtimecmp as required by the privileged spec.
+    logic mtime_interrupt;
+    assign mtime_interrupt = mtime_periodic ? pending[0] : mtime_match;
+
+    assign interrupt = mtime_interrupt || |(pending & pending_enable);
 
 endmodule
@@ -9,7 +9,24 @@
 
 module mcu #(
     parameter real CLK_FREQUENCY_MHZ,
-    parameter int  UART_BAUD_RATE
+    parameter int  UART_BAUD_RATE,
+    // High frequency configuration: register the peripheral bus address decoder
+    parameter bit  REGISTERED_BUS = 0,
+    // Tightly coupled data memory at TCM_START (stack and .tcm section, must match the linker
+    // script, see TCM_ENABLE in Makefile)
+    parameter bit  TCM_ENABLE = 0,
+    // Program memory size in KB (must match the linker script, see MEMORY_SIZE_KB in Makefile)
+    parameter int  MEMORY_SIZE_KB = 32,
+    // Number of word-interleaved program memory banks (see wishbone_ram.sv)
+    parameter int  MEMORY_BANKS = 1,
+    // Transaction counters and latency histograms of the peripheral bus (see wishbone_monitor.sv)
+    parameter bit  BUS_MONITOR = 0,
+    // Execute-in-place window of the QSPI flash at FLASH_START (reads as erased flash if disabled)
+    parameter bit  FLASH_ENABLE = 1,
+    // Number of harts (1 ... 8): hart 0 as above, every further hart has its own local memory and
+    // TCM and shares everything else through an arbiter in front of the peripheral interconnect.
+    // Only hart 0 gets the timer interrupt, the other harts only see inter-processor interrupts.
+    parameter int  NUM_CORES = 1
 ) (
     // Main system clk
     input logic clk,
@@ -40,10 +57,35 @@ module mcu #(
 
     // UART
     input  logic uart_rx_async,
-    output logic uart_tx
+    output logic uart_tx,
+
+    // Timer output compare / PWM
+    output logic [3:0] timer_pwm,
+
+    // QSPI flash (dq tristate buffers in the top level)
+    output logic       flash_cs_n,
+    output logic       flash_sck,
+    output logic [3:0] flash_dq_out,
+    output logic [3:0] flash_dq_oe,
+    input  logic [3:0] flash_dq_in
 );
     import constants::*;
 
+    localparam bit [31:0] MEMORY_SIZE = MEMORY_SIZE_KB * 256; // words
+
+    if (MEMORY_SIZE > MEMORY_SIZE_MAX) begin: memory_size_check
+        $error("MEMORY_SIZE_KB exceeds the memory region");
+    end
+
+    if (NUM_CORES < 1 || NUM_CORES > 8) begin: num_cores_check
+        $error("NUM_CORES must be between 1 and 8");
+    end
+
+    // Every hart has its stack in its own TCM (without it, all harts would share one stack in RAM)
+    if (NUM_CORES > 1 && !TCM_ENABLE) begin: tcm_enable_check
+        $error("NUM_CORES > 1 requires TCM_ENABLE");
+    end
+
     // --------------------------------------------------------------------------------------------
     // |                                     Synchronization                                      |
     // --------------------------------------------------------------------------------------------
@@ -92,14 +134,27 @@ module mcu #(
     // Wishbone
     wishbone_interface fetch_bus();
     wishbone_interface mem_bus();
+    wishbone_interface peripheral_bus();
+
+    // Masters of the peripheral bus: 0: memory port of hart 0, 2n - 1 / 2n: memory / fetch port
+    // of hart n > 0 (see Harts below)
+    localparam int NUM_BUS_MASTERS = 2 * NUM_CORES - 1;
+    wishbone_interface bus_masters[NUM_BUS_MASTERS]();
+
+    // Mailbox (see wishbone_mailbox.sv)
+    /*verilator lint_off UNUSED*/
+    logic [NUM_CORES-1:0] hart_run;
+    /*verilator lint_on UNUSED*/
+    logic [NUM_CORES-1:0] hart_ipi;
 
     logic external_interrupt;
     assign external_interrupt = |{
         uart_interrupt,
-        test_interrupt
+        test_interrupt,
+        hart_ipi[0]
     };
 
-    // Instantiate CPU
+    // Instantiate CPU (hart 0)
     cpu cpu(
         .clk(clk),
         .rst(rst),
@@ -109,50 +164,213 @@ module mcu #(
         .timer_interrupt_in(timer_interrupt)
     );
 
+    // --------------------------------------------------------------------------------------------
+    // |                                          Harts                                           |
+    // --------------------------------------------------------------------------------------------
+
+    // Harts 1 ... NUM_CORES - 1 fetch from their local memory (or through the arbiter from the
+    // program memory and the flash), their loads and stores go to the TCM, the local memory or
+    // through the arbiter to the peripheral bus. Independent work in the local memories and TCMs
+    // runs in parallel, only accesses to the shared address range wait for each other.
+    localparam bit [31:0] SHARED_START = MEMORY_START;
+    localparam bit [31:0] SHARED_SIZE  = FLASH_START + FLASH_SIZE - MEMORY_START;
+
+    // A shared access may wait for all other masters, each up to the timeout of the interconnect
+    localparam int SHARED_TIMEOUT = 256 * NUM_BUS_MASTERS - 1;
+
+    for (genvar hart = 1; hart < NUM_CORES; hart++) begin: harts
+        wishbone_interface fetch_bus();
+        wishbone_interface mem_bus();
+        wishbone_interface local_bus();
+        wishbone_interface fetch_bus_slaves[2]();
+        wishbone_interface local_bus_slaves[2]();
+
+        // Held in reset until started by another hart (run register of the mailbox)
+        logic hart_rst = 1;
+        always_ff @(posedge clk) begin
+            hart_rst <= rst || !hart_run[hart];
+        end
+
+        cpu cpu(
+            .clk(clk),
+            .rst(hart_rst),
+            .memory_fetch_port(fetch_bus.master),
+            .memory_mem_port(mem_bus.master),
+            .external_interrupt_in(hart_ipi[hart]),
+            // mtime/mtimecmp belong to hart 0, these harts never take a timer interrupt
+            .timer_interrupt_in(1'b0)
+        );
+
+        // Fetch bus interconnect (local memory and shared)
+        wishbone_interconnect #(
+            .NUM_SLAVES(2),
+            .SLAVE_ADDRESS({LOCAL_START, SHARED_START}),
+            .SLAVE_SIZE({LOCAL_SIZE, SHARED_SIZE}),
+            .TIMEOUT(SHARED_TIMEOUT)
+        ) fetch_bus_interconnect (
+            .clk(clk),
+            .rst(hart_rst),
+            .master(fetch_bus),
+            .slaves(fetch_bus_slaves)
+        );
+
+        // Tightly coupled data memory (stack and .tcm of this hart)
+        wishbone_tcm #(
+            .ADDRESS(TCM_START),
+            .SIZE(TCM_ENABLE ? TCM_SIZE : 0)
+        ) tcm (
+            .clk(clk_mem),
+            .rst(hart_rst),
+            .cpu(mem_bus.slave),
+            .bus(local_bus.master)
+        );
+
+        // Memory bus interconnect (local memory and shared)
+        wishbone_interconnect #(
+            .NUM_SLAVES(2),
+            .SLAVE_ADDRESS({LOCAL_START, SHARED_START}),
+            .SLAVE_SIZE({LOCAL_SIZE, SHARED_SIZE}),
+            .TIMEOUT(SHARED_TIMEOUT)
+        ) local_bus_interconnect (
+            .clk(clk),
+            .rst(hart_rst),
+            .master(local_bus),
+            .slaves(local_bus_slaves)
+        );
+
+        // Local memory (code and data, loaded by __start, see hades-v.ld.in)
+        wishbone_ram #(
+            .ADDRESS(LOCAL_START),
+            .SIZE(LOCAL_SIZE),
+            .INIT(0)
+        ) ram (
+            .clk(clk_mem),
+            .rst(hart_rst),
+            .port_a(fetch_bus_slaves[0]),
+            .port_b(local_bus_slaves[0])
+        );
+
+        // Shared accesses -> arbiter
+        assign bus_masters[2 * hart - 1].cyc      = local_bus_slaves[1].cyc;
+        assign bus_masters[2 * hart - 1].stb      = local_bus_slaves[1].stb;
+        assign bus_masters[2 * hart - 1].adr      = local_bus_slaves[1].adr;
+        assign bus_masters[2 * hart - 1].sel      = local_bus_slaves[1].sel;
+        assign bus_masters[2 * hart - 1].we       = local_bus_slaves[1].we;
+        assign bus_masters[2 * hart - 1].dat_mosi = local_bus_slaves[1].dat_mosi;
+        assign local_bus_slaves[1].ack            = bus_masters[2 * hart - 1].ack;
+        assign local_bus_slaves[1].err            = bus_masters[2 * hart - 1].err;
+        assign local_bus_slaves[1].dat_miso       = bus_masters[2 * hart - 1].dat_miso;
+
+        assign bus_masters[2 * hart].cyc          = fetch_bus_slaves[1].cyc;
+        assign bus_masters[2 * hart].stb          = fetch_bus_slaves[1].stb;
+        assign bus_masters[2 * hart].adr          = fetch_bus_slaves[1].adr;
+        assign bus_masters[2 * hart].sel          = fetch_bus_slaves[1].sel;
+        assign bus_masters[2 * hart].we           = fetch_bus_slaves[1].we;
+        assign bus_masters[2 * hart].dat_mosi     = fetch_bus_slaves[1].dat_mosi;
+        assign fetch_bus_slaves[1].ack            = bus_masters[2 * hart].ack;
+        assign fetch_bus_slaves[1].err            = bus_masters[2 * hart].err;
+        assign fetch_bus_slaves[1].dat_miso       = bus_masters[2 * hart].dat_miso;
+    end
+
     // --------------------------------------------------------------------------------------------
     // |                                       Peripherals                                        |
     // --------------------------------------------------------------------------------------------
 
+    // Fetch bus interconnect (program memory and flash)
+    wishbone_interface fetch_bus_slaves[2]();
+    wishbone_interconnect #(
+        .NUM_SLAVES(2),
+        .SLAVE_ADDRESS({MEMORY_START, FLASH_START}),
+        .SLAVE_SIZE({MEMORY_SIZE, FLASH_SIZE})
+    ) fetch_bus_interconnect (
+        .clk(clk),
+        .rst(rst),
+        .master(fetch_bus),
+        .slaves(fetch_bus_slaves)
+    );
+
+    // Tightly coupled data memory (bypasses the interconnect)
+    wishbone_tcm #(
+        .ADDRESS(TCM_START),
+        .SIZE(TCM_ENABLE ? TCM_SIZE : 0)
+    ) tcm (
+        .clk(clk_mem),
+        .rst(rst),
+        .cpu(mem_bus.slave),
+        .bus(bus_masters[0])
+    );
+
+    // Peripheral bus arbiter (pass-through for a single hart)
+    localparam int BUS_MASTER_BITS = (NUM_BUS_MASTERS > 1) ? $clog2(NUM_BUS_MASTERS) : 1;
+
+    logic [BUS_MASTER_BITS-1:0] bus_grant;
+
+    // Hart of the granted master (hart ID register of the mailbox, mtimeh latch of the timer)
+    logic [2:0] bus_hart;
+    assign bus_hart = 3'((32'(bus_grant) + 1) / 2);
+
+    wishbone_arbiter #(
+        .NUM_MASTERS(NUM_BUS_MASTERS)
+    ) peripheral_bus_arbiter (
+        .clk(clk),
+        .rst(rst),
+        .masters(bus_masters),
+        .slave(peripheral_bus.master),
+        .grant(bus_grant)
+    );
+
     // Memory bus interconnect
-    wishbone_interface mem_bus_slaves[9]();
+    localparam int NUM_BUS_SLAVES = 12;
+    localparam bit [32*NUM_BUS_SLAVES-1:0] BUS_SLAVE_ADDRESS = {
+        MEMORY_START,
+        LEDS_START,
+        BUTTONS_START,
+        SWITCHES_START,
+        SEGMENTS_START,
+        UART_START,
+        TIMER_START,
+        VGA_START,
+        TEST_START,
+        BUS_MONITOR_START,
+        FLASH_START,
+        MAILBOX_START
+    };
+    localparam bit [32*NUM_BUS_SLAVES-1:0] BUS_SLAVE_SIZE = {
+        MEMORY_SIZE,
+        LEDS_SIZE,
+        BUTTONS_SIZE,
+        SWITCHES_SIZE,
+        SEGMENTS_SIZE,
+        UART_SIZE,
+        TIMER_SIZE,
+        VGA_SIZE,
+        TEST_SIZE,
+        BUS_MONITOR_SIZE,
+        FLASH_SIZE,
+        MAILBOX_SIZE
+    };
+
+    wishbone_interface mem_bus_slaves[NUM_BUS_SLAVES]();
     wishbone_interconnect #(
-        .NUM_SLAVES(9),
-        .SLAVE_ADDRESS({
-            MEMORY_START,
-            LEDS_START,
-            BUTTONS_START,
-            SWITCHES_START,
-            SEGMENTS_START,
-            UART_START,
-            TIMER_START,
-            VGA_START,
-            TEST_START
-        }),
-        .SLAVE_SIZE({
-            MEMORY_SIZE,
-            LEDS_SIZE,
-            BUTTONS_SIZE,
-            SWITCHES_SIZE,
-            SEGMENTS_SIZE,
-            UART_SIZE,
-            TIMER_SIZE,
-            VGA_SIZE,
-            TEST_SIZE
-        })
+        .NUM_SLAVES(NUM_BUS_SLAVES),
+        .SLAVE_ADDRESS(BUS_SLAVE_ADDRESS),
+        .SLAVE_SIZE(BUS_SLAVE_SIZE),
+        .REGISTERED_DECODE(REGISTERED_BUS)
     ) peripheral_bus_interconnect (
         .clk(clk),
         .rst(rst),
-        .master(mem_bus),
+        .master(peripheral_bus),
         .slaves(mem_bus_slaves)
     );
 
     wishbone_ram #(
         .ADDRESS(MEMORY_START),
-        .SIZE(MEMORY_SIZE)
+        .SIZE(MEMORY_SIZE),
+        .NUM_BANKS(MEMORY_BANKS)
     ) ram (
         .clk(clk_mem),
         .rst(rst),
-        .port_a(fetch_bus.slave),
+        .port_a(fetch_bus_slaves[0]),
         .port_b(mem_bus_slaves[0])
     );
 
@@ -216,12 +434,16 @@ module mcu #(
     wishbone_timer #(
         .ADDRESS(TIMER_START),
         .SIZE(TIMER_SIZE),
-        .CLK_FREQUENCY_MHZ(CLK_FREQUENCY_MHZ)
+        .CLK_FREQUENCY_MHZ(CLK_FREQUENCY_MHZ),
+        .NUM_CHANNELS(4),
+        .NUM_HARTS(NUM_CORES)
     ) wb_timer (
         .clk(clk),
         .rst(rst),
+        .hart(bus_hart),
 
         .interrupt(timer_interrupt),
+        .pwm(timer_pwm),
 
         .wishbone(mem_bus_slaves[6])
     );
@@ -255,4 +477,64 @@ module mcu #(
         .wishbone(mem_bus_slaves[8])
     );
 
+    // Observes the interconnect (the TCM is not part of it)
+    wishbone_monitor #(
+        .ADDRESS(BUS_MONITOR_START),
+        .SIZE(BUS_MONITOR_SIZE),
+        .NUM_SLAVES(NUM_BUS_SLAVES),
+        .SLAVE_ADDRESS(BUS_SLAVE_ADDRESS),
+        .SLAVE_SIZE(BUS_SLAVE_SIZE),
+        .ENABLE(BUS_MONITOR)
+    ) wb_bus_monitor (
+        .clk(clk),
+        .rst(rst),
+        .bus(peripheral_bus.monitor),
+        .wishbone(mem_bus_slaves[9])
+    );
+
+    // Code and read only data (fetch port and memory port)
+    if (FLASH_ENABLE) begin: flash
+        wishbone_flash #(
+            .ADDRESS(FLASH_START),
+            .SIZE(FLASH_SIZE)
+        ) wb_flash (
+            .clk(clk),
+            .rst(rst),
+            .flash_cs_n(flash_cs_n),
+            .flash_sck(flash_sck),
+            .flash_dq_out(flash_dq_out),
+            .flash_dq_oe(flash_dq_oe),
+            .flash_dq_in(flash_dq_in),
+            .fetch_port(fetch_bus_slaves[1]),
+            .data_port(mem_bus_slaves[10])
+        );
+    end
+    else begin: no_flash
+        // Reads return 0xFFFFFFFF (erased), e.g. for the image check of the bootloader
+        assign fetch_bus_slaves[1].ack      = fetch_bus_slaves[1].cyc && fetch_bus_slaves[1].stb;
+        assign fetch_bus_slaves[1].err      = 0;
+        assign fetch_bus_slaves[1].dat_miso = 32'hFFFF_FFFF;
+        assign mem_bus_slaves[10].ack       = mem_bus_slaves[10].cyc && mem_bus_slaves[10].stb;
+        assign mem_bus_slaves[10].err       = 0;
+        assign mem_bus_slaves[10].dat_miso  = 32'hFFFF_FFFF;
+
+        assign flash_cs_n   = 1;
+        assign flash_sck    = 0;
+        assign flash_dq_out = 0;
+        assign flash_dq_oe  = 0;
+    end
+
+    wishbone_mailbox #(
+        .ADDRESS(MAILBOX_START),
+        .SIZE(MAILBOX_SIZE),
+        .NUM_HARTS(NUM_CORES)
+    ) wb_mailbox (
+        .clk(clk),
+        .rst(rst),
+        .hart(bus_hart),
+        .run(hart_run),
+        .ipi(hart_ipi),
+        .wishbone(mem_bus_slaves[11])
+    );
+
 endmodule
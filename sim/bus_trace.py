@@ -0,0 +1,100 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: bus_trace.py
+#
+# Summarizes the transaction trace of the bus monitor (bus_trace.bin, written by
+# lib/wishbone/wishbone_monitor.sv when the simulation is started with +bus_trace):
+# transactions, read/write mix, errors and a latency histogram per slave.
+#
+# Usage:
+#   bus_trace.py [--csv FILE] bus_trace.bin
+
+import argparse
+import struct
+import sys
+
+# Order of the slaves in the interconnect (see BUS_SLAVE_ADDRESS in rtl/mcu.sv)
+SLAVE_NAMES = ["memory", "leds", "buttons", "switches", "segments", "uart", "timer", "vga", "test",
+               "bus_monitor", "flash", "mailbox"]
+
+MAGIC = 0x48444254  # "HDBT"
+
+# Same bins as the hardware counters: 1, 2, 3-4, 5-8, ...
+HISTOGRAM_BINS = 8
+
+
+def histogram_bin(latency):
+    for i in range(HISTOGRAM_BINS - 1):
+        if latency <= 1 << i:
+            return i
+    return HISTOGRAM_BINS - 1
+
+
+def bin_label(i):
+    if i == HISTOGRAM_BINS - 1:
+        return f">{1 << (i - 1)}"
+    low = (1 << (i - 1)) + 1 if i > 0 else 1
+    return str(low) if low == 1 << i else f"{low}-{1 << i}"
+
+
+def read_trace(path):
+    with open(path, "rb") as trace_file:
+        data = trace_file.read()
+    if len(data) < 4:
+        raise ValueError(f"{path} is empty")
+    for order in ("<", ">"):
+        if struct.unpack_from(order + "I", data)[0] == MAGIC:
+            break
+    else:
+        raise ValueError(f"{path} is not a bus trace")
+    for offset in range(4, len(data) - 11, 12):
+        cycle, address, info = struct.unpack_from(order + "III", data, offset)
+        yield cycle, address, info & 0xFF, (info >> 8) & 0xFF, info >> 16
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Summarize a wishbone monitor trace")
+    parser.add_argument("trace", help="bus_trace.bin")
+    parser.add_argument("--csv", metavar="FILE", help="also write all transactions as csv")
+    args = parser.parse_args()
+
+    stats = {}
+    csv_file = open(args.csv, "w") if args.csv else None
+    if csv_file:
+        csv_file.write("cycle,address,slave,write,error,latency\n")
+
+    for cycle, address, slave, flags, latency in read_trace(args.trace):
+        name = SLAVE_NAMES[slave] if slave < len(SLAVE_NAMES) else "unmapped"
+        entry = stats.setdefault(name, {"reads": 0, "writes": 0, "errors": 0, "latency": 0, "max": 0,
+                                        "histogram": [0] * HISTOGRAM_BINS})
+        if flags & 0b10:
+            entry["errors"] += 1
+        elif flags & 0b01:
+            entry["writes"] += 1
+        else:
+            entry["reads"] += 1
+        entry["latency"] += latency
+        entry["max"] = max(entry["max"], latency)
+        entry["histogram"][histogram_bin(latency)] += 1
+        if csv_file:
+            csv_file.write(f"{cycle},0x{address:08x},{name},{flags & 1},{(flags >> 1) & 1},{latency}\n")
+
+    if csv_file:
+        csv_file.close()
+
+    labels = [bin_label(i) for i in range(HISTOGRAM_BINS)]
+    print(f"{'slave':<12} {'reads':>9} {'writes':>9} {'errors':>7} {'avg lat':>8} {'max':>6}  "
+          + " ".join(f"{label:>7}" for label in labels))
+    for name in sorted(stats, key=lambda name: -stats[name]["latency"]):
+        entry = stats[name]
+        count = entry["reads"] + entry["writes"] + entry["errors"]
+        print(f"{name:<12} {entry['reads']:9d} {entry['writes']:9d} {entry['errors']:7d} "
+              f"{entry['latency'] / count:8.2f} {entry['max']:6d}  "
+              + " ".join(f"{value:7d}" for value in entry["histogram"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
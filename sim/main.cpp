@@ -0,0 +1,156 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: main.cpp
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Simulation main loop with configurable waveform tracing (replaces verilator --main).         |
+// |                                                                                              |
+// | The trace file is opened here, the triggers (start/stop cycle, PC, failing test) are         |
+// | evaluated in sim/top.sv, which calls trace_control() through DPI. Cycles without tracing     |
+// | don't write anything, so partial traces cost only the traced cycles.                         |
+// |                                                                                              |
+// | Plusargs handled here:                                                                       |
+// |     +notrace                no waveform                                                      |
+// |     +trace_depth=<levels>   hierarchy levels below the top (default: all)                   |
+// |     +trace_scope=<name>     only trace this hierarchy, e.g. top.mcu.cpu                      |
+// |     +trace_ring=<cycles>    ring buffer mode: alternate between sim_ring_0.fst and           |
+// |                             sim_ring_1.fst, each covering <cycles>. The files are kept on    |
+// |                             a failure and deleted otherwise.                                 |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <verilated.h>
+#include <verilated_fst_c.h>
+
+#include "top.h"
+#include "top__Dpi.h"
+
+namespace {
+
+// Commands of sim/top.sv (trace_command_t)
+enum TraceCommand {
+    TRACE_START  = 0,
+    TRACE_STOP   = 1,
+    TRACE_ROTATE = 2,
+    TRACE_FAIL   = 3
+};
+
+std::unique_ptr<VerilatedFstC> trace;
+bool tracing      = false;
+bool ring         = false;
+bool failed       = false;
+int  ring_segment = 0;
+
+std::string ringFileName(int segment) {
+    return "sim_ring_" + std::to_string(segment) + ".fst";
+}
+
+// Value of +<name>=<value>, nullptr if not given
+const char *plusargValue(VerilatedContext *context, const char *name) {
+    const std::string prefix = std::string(name) + "=";
+    const char *match = context->commandArgsPlusMatch(prefix.c_str());
+    if (match[0] == '\0') {
+        return nullptr;
+    }
+    return match + prefix.size() + 1; // skip '+'
+}
+
+} // namespace
+
+void trace_control(int command) {
+    if (!trace) {
+        return;
+    }
+    switch (command) {
+        case TRACE_START:
+            tracing = true;
+            break;
+        case TRACE_STOP:
+            tracing = false;
+            break;
+        case TRACE_ROTATE:
+            // the previous segment stays, the older one is overwritten
+            if (ring && !failed) {
+                trace->close();
+                ring_segment ^= 1;
+                trace->open(ringFileName(ring_segment).c_str());
+            }
+            break;
+        case TRACE_FAIL:
+            failed = true;
+            break;
+        default:
+            break;
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::unique_ptr<VerilatedContext> context{new VerilatedContext};
+    context->commandArgs(argc, argv);
+
+    const std::unique_ptr<top> model{new top{context.get(), ""}};
+
+    // Tracing
+    if (context->commandArgsPlusMatch("notrace")[0] == '\0') {
+        const char *depth_value = plusargValue(context.get(), "trace_depth");
+        const char *scope = plusargValue(context.get(), "trace_scope");
+        int depth = depth_value ? std::atoi(depth_value) : 99;
+        ring = plusargValue(context.get(), "trace_ring") != nullptr;
+
+        context->traceEverOn(true);
+        trace = std::make_unique<VerilatedFstC>();
+        if (depth_value || scope) {
+            // The levels of model->trace are not a filter, only dumpvars limits the traced signals
+            model->trace(trace.get(), 0);
+            trace->dumpvars(depth, scope ? scope : "top");
+        }
+        else {
+            model->trace(trace.get(), depth);
+        }
+        trace->open(ring ? ringFileName(0).c_str() : "sim.fst");
+        tracing = true;
+    }
+
+    // Main loop (timing based, the clocks are generated in sim/top.sv)
+    while (!context->gotFinish()) {
+        model->eval();
+        if (tracing) {
+            trace->dump(context->time());
+        }
+        if (!model->eventsPending()) {
+            break;
+        }
+        context->time(model->nextTimeSlot());
+    }
+
+    if (!context->gotFinish()) {
+        VL_PRINTF("Simulation stopped: no more events\n");
+    }
+    model->final();
+
+    if (trace) {
+        trace->close();
+        if (ring && !failed) {
+            std::remove(ringFileName(0).c_str());
+            std::remove(ringFileName(1).c_str());
+            VL_PRINTF("No failure, ring buffer trace discarded\n");
+        }
+        else if (ring) {
+            VL_PRINTF("Trace before the failure: %s (previous cycles: %s)\n",
+                ringFileName(ring_segment).c_str(), ringFileName(ring_segment ^ 1).c_str());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,284 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: pipeline_monitor.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Simulation-only pipeline statistics, written to pipeline.json at the end of the simulation. |
+// |                                                                                              |
+// | Slots are the input registers of decode, execute, memory and writeback (index 0..3).         |
+// | A stall originates in the lowest stage signalling STALL to its predecessor while its own     |
+// | successor is READY, the source of the stall is derived from that stage:                      |
+// |     decode:    load-use (data hazard)                                                        |
+// |     execute:   execute (multi cycle operation)                                               |
+// |     memory:    memory bus wait (or memory, if no bus access is pending)                      |
+// |     writeback: writeback                                                                     |
+// | Fetch bus wait cycles are counted separately (request pending without ack).                  |
+// | Bubbles carry the cause of their insertion down the pipeline: stall source of the stage      |
+// | that inserted them, flush (JUMP) or fetch (no instruction available).                        |
+// |                                                                                              |
+// | The report is JSON with a fixed key order, so two runs can be diffed directly.               |
+// | Stall hotspots are limited to the +pipeline_hotspots=<n> (default 32) most expensive PCs.    |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module pipeline_monitor (
+    input logic clk,
+    input logic rst,
+
+    // Bus ports of the CPU
+    input logic        fetch_request,
+    input logic        fetch_ack,
+    input logic [31:0] fetch_pc,
+    input logic        mem_request,
+    input logic        mem_ack,
+
+    // Status into decode/execute/memory/writeback
+    input pipeline_status::forwards_t  decode_status_forwards,
+    input pipeline_status::forwards_t  execute_status_forwards,
+    input pipeline_status::forwards_t  memory_status_forwards,
+    input pipeline_status::forwards_t  writeback_status_forwards,
+
+    // Status out of decode/execute/memory/writeback (towards the previous stage)
+    input pipeline_status::backwards_t decode_status_backwards,
+    input pipeline_status::backwards_t execute_status_backwards,
+    input pipeline_status::backwards_t memory_status_backwards,
+    input pipeline_status::backwards_t writeback_status_backwards,
+
+    // Program counter of the instruction in decode/execute/memory/writeback
+    input logic [31:0] decode_pc,
+    input logic [31:0] execute_pc,
+    input logic [31:0] memory_pc,
+    input logic [31:0] writeback_pc
+);
+    import pipeline_status::*;
+
+    localparam int SLOTS = 4;
+    localparam string SLOT_NAMES[SLOTS] = '{"decode", "execute", "memory", "writeback"};
+
+    typedef enum int {
+        CAUSE_NONE,
+        CAUSE_FETCH,
+        CAUSE_FLUSH,
+        CAUSE_LOAD_USE,
+        CAUSE_EXECUTE,
+        CAUSE_MEMORY,
+        CAUSE_MEMORY_BUS,
+        CAUSE_WRITEBACK,
+        CAUSE_FETCH_BUS,
+        CAUSE_OTHER,
+        CAUSE_COUNT
+    } cause_t;
+
+    localparam string CAUSE_NAMES[CAUSE_COUNT] = '{
+        "none", "fetch", "flush", "load_use", "execute", "memory", "memory_bus", "writeback",
+        "fetch_bus", "other"
+    };
+
+    forwards_t   forwards  [SLOTS];
+    backwards_t  backwards [SLOTS];
+    logic [31:0] slot_pc   [SLOTS];
+
+    assign forwards  = '{decode_status_forwards, execute_status_forwards, memory_status_forwards, writeback_status_forwards};
+    assign backwards = '{decode_status_backwards, execute_status_backwards, memory_status_backwards, writeback_status_backwards};
+    assign slot_pc   = '{decode_pc, execute_pc, memory_pc, writeback_pc};
+
+    // Counters
+    longint unsigned cycles = 0;
+    longint unsigned valid_cycles   [SLOTS];
+    longint unsigned bubble_cycles  [SLOTS];
+    longint unsigned trap_cycles    [SLOTS];
+    longint unsigned stalled_cycles [SLOTS];
+    longint unsigned bubble_causes  [SLOTS][CAUSE_COUNT];
+    longint unsigned stall_sources  [CAUSE_COUNT];
+    longint unsigned flushes        [SLOTS];
+    longint unsigned hotspots       [int unsigned][CAUSE_COUNT];
+    longint unsigned hotspot_total  [int unsigned];
+
+    // Cause of the bubble expected in each slot in the current cycle
+    cause_t slot_cause [SLOTS];
+
+    int max_hotspots = 32;
+
+    initial begin
+        if (!$value$plusargs("pipeline_hotspots=%d", max_hotspots)) begin
+            max_hotspots = 32;
+        end
+        foreach (slot_cause[slot]) begin
+            slot_cause[slot]     = CAUSE_NONE;
+            valid_cycles[slot]   = 0;
+            bubble_cycles[slot]  = 0;
+            trap_cycles[slot]    = 0;
+            stalled_cycles[slot] = 0;
+            flushes[slot]        = 0;
+            foreach (bubble_causes[slot][cause]) begin
+                bubble_causes[slot][cause] = 0;
+            end
+        end
+        foreach (stall_sources[cause]) begin
+            stall_sources[cause] = 0;
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Statistics                                        |
+    // --------------------------------------------------------------------------------------------
+
+    // Stall source if the stage of this slot is where the stall originates
+    function automatic cause_t stall_source(int slot);
+        if (backwards[slot] != STALL || (slot < SLOTS - 1 && backwards[slot + 1] == STALL)) begin
+            return CAUSE_NONE;
+        end
+        case (slot)
+            0: return CAUSE_LOAD_USE;
+            1: return CAUSE_EXECUTE;
+            2: return (mem_request && !mem_ack) ? CAUSE_MEMORY_BUS : CAUSE_MEMORY;
+            default: return CAUSE_WRITEBACK;
+        endcase
+    endfunction
+
+    function automatic void add_hotspot(logic [31:0] pc, cause_t cause);
+        if (!hotspot_total.exists(pc)) begin
+            hotspot_total[pc] = 0;
+            for (int i = 0; i < CAUSE_COUNT; i++) begin
+                hotspots[pc][i] = 0;
+            end
+        end
+        hotspot_total[pc]++;
+        hotspots[pc][cause]++;
+    endfunction
+
+    always @(posedge clk) begin
+        if (!rst) begin
+            cause_t next_cause [SLOTS];
+            cycles++;
+
+            for (int slot = 0; slot < SLOTS; slot++) begin
+                cause_t source;
+                source = stall_source(slot);
+
+                // occupancy
+                case (forwards[slot])
+                    VALID:   valid_cycles[slot]++;
+                    BUBBLE: begin
+                        bubble_cycles[slot]++;
+                        bubble_causes[slot][slot_cause[slot] == CAUSE_NONE ? CAUSE_OTHER : slot_cause[slot]]++;
+                    end
+                    default: trap_cycles[slot]++;
+                endcase
+                if (backwards[slot] == STALL) begin
+                    stalled_cycles[slot]++;
+                end
+
+                // stall origin
+                if (source != CAUSE_NONE) begin
+                    stall_sources[source]++;
+                    add_hotspot(slot_pc[slot], source);
+                end
+
+                // flush origin (lowest stage requesting a jump)
+                if (backwards[slot] == JUMP && (slot == SLOTS - 1 || backwards[slot + 1] != JUMP)) begin
+                    flushes[slot]++;
+                end
+            end
+
+            // fetch bus wait
+            if (fetch_request && !fetch_ack && backwards[0] == READY) begin
+                stall_sources[CAUSE_FETCH_BUS]++;
+                add_hotspot(fetch_pc, CAUSE_FETCH_BUS);
+            end
+
+            // bubble causes for the next cycle (slot advances if its producer is not stalled)
+            for (int slot = 0; slot < SLOTS; slot++) begin
+                next_cause[slot] = slot_cause[slot];
+                if (backwards[slot] == JUMP) begin
+                    next_cause[slot] = CAUSE_FLUSH;
+                end
+                else if (backwards[slot] == READY) begin
+                    if (slot == 0) begin
+                        next_cause[slot] = CAUSE_FETCH;
+                    end
+                    else if (stall_source(slot - 1) != CAUSE_NONE) begin
+                        next_cause[slot] = stall_source(slot - 1);
+                    end
+                    else begin
+                        next_cause[slot] = forwards[slot - 1] == BUBBLE ? slot_cause[slot - 1] : CAUSE_NONE;
+                    end
+                end
+            end
+            slot_cause = next_cause;
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                          Report                                          |
+    // --------------------------------------------------------------------------------------------
+
+    final begin
+        int file;
+        int unsigned ranked[$];
+        longint unsigned commits;
+
+        file    = $fopen("pipeline.json", "w");
+        commits = valid_cycles[SLOTS - 1];
+
+        // most expensive PCs first, equal counts by address
+        foreach (hotspot_total[pc]) begin
+            ranked.push_back(pc);
+        end
+        ranked.sort() with ({~hotspot_total[item], item});
+        if (ranked.size() > max_hotspots) begin
+            ranked = ranked[0:max_hotspots - 1];
+        end
+
+        $fdisplay(file, "{");
+        $fdisplay(file, "    \"cycles\": %0d,", cycles);
+        $fdisplay(file, "    \"commits\": %0d,", commits);
+        $fdisplay(file, "    \"ipc_milli\": %0d,", cycles == 0 ? 0 : (commits * 1000) / cycles);
+
+        $fdisplay(file, "    \"stages\": {");
+        for (int slot = 0; slot < SLOTS; slot++) begin
+            $fdisplay(file, "        \"%s\": {", SLOT_NAMES[slot]);
+            $fdisplay(file, "            \"valid\": %0d,", valid_cycles[slot]);
+            $fdisplay(file, "            \"bubble\": %0d,", bubble_cycles[slot]);
+            $fdisplay(file, "            \"trap\": %0d,", trap_cycles[slot]);
+            $fdisplay(file, "            \"stalled\": %0d,", stalled_cycles[slot]);
+            $fdisplay(file, "            \"flushes\": %0d,", flushes[slot]);
+            $fdisplay(file, "            \"utilization_milli\": %0d,", cycles == 0 ? 0 : (valid_cycles[slot] * 1000) / cycles);
+            $fwrite(file, "            \"bubble_causes\": {");
+            for (int cause = CAUSE_FETCH; cause <= CAUSE_OTHER; cause++) begin
+                $fwrite(file, "\"%s\": %0d%s", CAUSE_NAMES[cause], bubble_causes[slot][cause], cause == CAUSE_OTHER ? "" : ", ");
+            end
+            $fdisplay(file, "}");
+            $fdisplay(file, "        }%s", slot == SLOTS - 1 ? "" : ",");
+        end
+        $fdisplay(file, "    },");
+
+        $fwrite(file, "    \"stall_sources\": {");
+        for (int cause = CAUSE_LOAD_USE; cause <= CAUSE_FETCH_BUS; cause++) begin
+            $fwrite(file, "\"%s\": %0d%s", CAUSE_NAMES[cause], stall_sources[cause], cause == CAUSE_FETCH_BUS ? "" : ", ");
+        end
+        $fdisplay(file, "},");
+
+        $fdisplay(file, "    \"hotspots\": [");
+        foreach (ranked[i]) begin
+            $fwrite(file, "        {\"pc\": \"0x%08x\", \"total\": %0d", ranked[i], hotspot_total[ranked[i]]);
+            for (int cause = CAUSE_LOAD_USE; cause <= CAUSE_FETCH_BUS; cause++) begin
+                if (hotspots[ranked[i]][cause] != 0) begin
+                    $fwrite(file, ", \"%s\": %0d", CAUSE_NAMES[cause], hotspots[ranked[i]][cause]);
+                end
+            end
+            $fdisplay(file, "}%s", i == ranked.size() - 1 ? "" : ",");
+        end
+        $fdisplay(file, "    ]");
+        $fdisplay(file, "}");
+        $fclose(file);
+        $display("Pipeline report written to pipeline.json");
+    end
+
+endmodule
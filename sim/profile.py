@@ -0,0 +1,183 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: profile.py
+#
+# Maps the PC samples of the simulation profiler (sim/profiler.sv, profile.txt) to the
+# functions of the ELF file and prints a flat profile and a call graph in the style of gprof.
+# Optionally writes the sampled call stacks in the folded format of flamegraph.pl.
+#
+# Usage:
+#   profile.py [--folded FILE] [--top N] out.elf profile.txt
+#
+# Without function symbols (assembly tests) all code labels are used instead.
+
+import argparse
+import bisect
+import struct
+import sys
+
+SHT_SYMTAB = 2
+SHF_EXECINSTR = 0x4
+STT_NOTYPE = 0
+STT_FUNC = 2
+
+
+# ------------------------------------------------------------------------------------------------
+# ELF symbols
+# ------------------------------------------------------------------------------------------------
+def read_symbols(path):
+    """Returns a sorted list of (address, size, name) of the code symbols of a 32 bit ELF."""
+    with open(path, "rb") as elf_file:
+        data = elf_file.read()
+    if data[:4] != b"\x7fELF" or data[4] != 1:
+        raise ValueError(f"{path} is not a 32 bit ELF file")
+
+    (shoff,) = struct.unpack_from("<I", data, 0x20)
+    shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+    sections = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize) for i in range(shnum)]
+
+    functions = {}
+    labels = {}
+    for _, sh_type, _, _, offset, size, link, _, _, entsize in sections:
+        if sh_type != SHT_SYMTAB:
+            continue
+        strtab_offset = sections[link][4]
+        for entry in range(offset, offset + size, entsize):
+            name_offset, value, sym_size, info, _, shndx = struct.unpack_from("<IIIBBH", data, entry)
+            if shndx == 0 or shndx >= len(sections) or not sections[shndx][2] & SHF_EXECINSTR:
+                continue
+            end = data.index(b"\0", strtab_offset + name_offset)
+            name = data[strtab_offset + name_offset:end].decode()
+            if not name or name.startswith("$"):
+                continue
+            if info & 0xF == STT_FUNC:
+                functions.setdefault(value, (sym_size, name))
+            elif info & 0xF == STT_NOTYPE:
+                labels.setdefault(value, (sym_size, name))
+
+    symbols = functions if functions else labels
+    return sorted((address, size, name) for address, (size, name) in symbols.items())
+
+
+class SymbolMap:
+    def __init__(self, symbols):
+        self.symbols = symbols
+        self.addresses = [address for address, _, _ in symbols]
+
+    def lookup(self, address):
+        index = bisect.bisect_right(self.addresses, address) - 1
+        if index >= 0:
+            start, size, name = self.symbols[index]
+            if size == 0 or address < start + size:
+                return name
+        return f"0x{address:08x}"
+
+
+# ------------------------------------------------------------------------------------------------
+# Profile data
+# ------------------------------------------------------------------------------------------------
+def read_profile(path):
+    profile = {"period": 1, "cycles": 0, "samples": 0, "pc": [], "call": [], "stack": []}
+    with open(path) as profile_file:
+        for line in profile_file:
+            fields = line.split()
+            if not fields or fields[0].startswith("#"):
+                continue
+            if fields[0] in ("period", "cycles", "samples"):
+                profile[fields[0]] = int(fields[1])
+            elif fields[0] == "pc":
+                profile["pc"].append((int(fields[1], 16), int(fields[2]), int(fields[3])))
+            elif fields[0] == "call":
+                profile["call"].append((int(fields[1], 16), int(fields[2], 16), int(fields[3])))
+            elif fields[0] == "stack":
+                frames = [int(frame, 16) for frame in fields[1].split(";")]
+                profile["stack"].append((frames, int(fields[2])))
+    return profile
+
+
+def flat_profile(profile, symbols):
+    self_samples = {}
+    stall_samples = {}
+    for address, samples, stalls in profile["pc"]:
+        name = symbols.lookup(address)
+        self_samples[name] = self_samples.get(name, 0) + samples
+        stall_samples[name] = stall_samples.get(name, 0) + stalls
+
+    calls = {}
+    edges = {}
+    for site, target, count in profile["call"]:
+        caller = symbols.lookup(site)
+        callee = symbols.lookup(target)
+        calls[callee] = calls.get(callee, 0) + count
+        edges[(caller, callee)] = edges.get((caller, callee), 0) + count
+
+    # inclusive samples: every function on a sampled stack counts once
+    total_samples = {}
+    for frames, samples in profile["stack"]:
+        for name in {symbols.lookup(frame) for frame in frames}:
+            total_samples[name] = total_samples.get(name, 0) + samples
+
+    return self_samples, stall_samples, total_samples, calls, edges
+
+
+def print_flat(profile, self_samples, stall_samples, total_samples, calls, top):
+    period = profile["period"]
+    samples = max(profile["samples"], 1)
+    print(f"Flat profile ({profile['cycles']} cycles, 1 sample = {period} cycle(s)):")
+    print()
+    print(f"{'%':>7} {'cumulative':>12} {'self':>12} {'stall':>12} {'total':>12} {'calls':>8}  name")
+    print(f"{'time':>7} {'cycles':>12} {'cycles':>12} {'cycles':>12} {'cycles':>12} {'':>8}")
+    cumulative = 0
+    ranking = sorted(self_samples, key=lambda name: (-self_samples[name], name))
+    for name in ranking[:top]:
+        cumulative += self_samples[name]
+        call_text = str(calls[name]) if name in calls else ""
+        print(f"{100.0 * self_samples[name] / samples:7.2f} {cumulative * period:12d} "
+              f"{self_samples[name] * period:12d} {stall_samples[name] * period:12d} "
+              f"{total_samples.get(name, 0) * period:12d} {call_text:>8}  {name}")
+
+
+def print_call_graph(edges, top):
+    print()
+    print("Call graph (caller -> callee, number of calls):")
+    print()
+    for (caller, callee), count in sorted(edges.items(), key=lambda item: (-item[1], item[0]))[:top]:
+        print(f"{count:10d}  {caller} -> {callee}")
+
+
+def write_folded(path, profile, symbols):
+    folded = {}
+    for frames, samples in profile["stack"]:
+        key = ";".join(symbols.lookup(frame) for frame in frames)
+        folded[key] = folded.get(key, 0) + samples * profile["period"]
+    with open(path, "w") as folded_file:
+        for key in sorted(folded):
+            folded_file.write(f"{key} {folded[key]}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Map simulation PC samples to ELF symbols")
+    parser.add_argument("elf", help="program (out.elf)")
+    parser.add_argument("profile", help="samples of the simulation (profile.txt)")
+    parser.add_argument("--folded", metavar="FILE", help="write folded stacks for flamegraph.pl")
+    parser.add_argument("--top", type=int, default=30, help="number of lines per table")
+    args = parser.parse_args()
+
+    symbols = SymbolMap(read_symbols(args.elf))
+    profile = read_profile(args.profile)
+
+    self_samples, stall_samples, total_samples, calls, edges = flat_profile(profile, symbols)
+    print_flat(profile, self_samples, stall_samples, total_samples, calls, args.top)
+    print_call_graph(edges, args.top)
+
+    if args.folded:
+        write_folded(args.folded, profile, symbols)
+        print()
+        print(f"Folded stacks written to {args.folded}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,246 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: profiler.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Simulation-only PC sampling profiler (enable with +profile).                                 |
+// |                                                                                              |
+// | Every PERIOD cycles (+profile_period=<cycles>, default 1) the current program counter is      |
+// | sampled. A sample counts as stall sample if no instruction was delivered in that cycle.      |
+// | Calls (jal/jalr with rd = ra) and returns (jalr zero, 0(ra)) are decoded from the delivered  |
+// | instruction words to track a shadow call stack, which yields the call edges and the sampled  |
+// | stacks for flame graphs.                                                                     |
+// |                                                                                              |
+// | The top level connects the fetch port of the CPU, i.e. PCs are attributed at fetch, a few    |
+// | instructions ahead of commit. Wrong-path fetches after taken branches are filtered for       |
+// | calls/returns: a direct call only counts if the next redirect goes to its target, an        |
+// | indirect call only if the next redirect follows it within REDIRECT_SHADOW sequential fetches |
+// | (otherwise it was fetched behind an older taken branch), a return only if it goes back       |
+// | behind a call site on the shadow stack.                                                      |
+// |                                                                                              |
+// | Every distinct shadow stack is a node of a call tree (child per call site), so a sample only |
+// | increments a counter of (node, pc). The stacks are formatted as strings in the final block.  |
+// |                                                                                              |
+// | At the end of the simulation the raw data is written to profile.txt, see sim/profile.py     |
+// | for mapping the addresses to ELF symbols.                                                    |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module profiler #(
+    parameter int MAX_DEPTH = 64,
+    // sequential fetches behind a jump before its redirect reaches the fetch port
+    parameter int REDIRECT_SHADOW = 1
+)(
+    input logic clk,
+    input logic rst,
+
+    // one instruction word delivered at pc (byte address)
+    input logic        instruction_valid,
+    input logic [31:0] pc,
+    input logic [31:0] instruction
+);
+
+    localparam logic [6:0] OPCODE_JAL  = 7'b1101111;
+    localparam logic [6:0] OPCODE_JALR = 7'b1100111;
+    localparam logic [4:0] REG_RA      = 5'd1;
+
+    bit enable = 0;
+    int unsigned period = 1;
+
+    // Raw data (addresses are mapped to symbols offline)
+    longint unsigned pc_samples    [int unsigned];
+    longint unsigned stall_samples [int unsigned];
+    longint unsigned call_count    [longint unsigned]; // {call site, destination}
+    longint unsigned stack_samples [longint unsigned]; // {stack node, pc}
+    longint unsigned total_cycles  = 0;
+    longint unsigned total_samples = 0;
+
+    // Call tree: node 0 is the empty stack, every other node is a call site below its parent
+    int unsigned node_parent [$] = '{0};
+    int unsigned node_site   [$] = '{0};
+    int unsigned node_child  [longint unsigned]; // {parent node, call site} -> node
+
+    // Shadow call stack (call site addresses and the call tree node of each depth)
+    int unsigned call_stack[$];
+    int unsigned node_stack[$];
+    int unsigned stack_node = 0;
+
+    // Fetch stream state
+    logic [31:0] current_pc   = 0;
+    logic [31:0] last_pc      = 0;
+    int unsigned countdown    = 0;
+
+    // Pending call/return, resolved by the next non-sequential fetch
+    typedef enum {NONE, CALL_DIRECT, CALL_INDIRECT, RETURN} pending_t;
+    pending_t    pending      = NONE;
+    logic [31:0] pending_pc   = 0;
+    logic [31:0] pending_dest = 0;
+
+    initial begin
+        enable = $test$plusargs("profile");
+        if (!$value$plusargs("profile_period=%d", period) || period == 0) begin
+            period = 1;
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                      Call tracking                                       |
+    // --------------------------------------------------------------------------------------------
+
+    function automatic logic [31:0] jal_target(logic [31:0] address, logic [31:0] word);
+        logic [31:0] offset = {{12{word[31]}}, word[19:12], word[20], word[30:21], 1'b0};
+        return address + offset;
+    endfunction
+
+    function automatic void push_call(logic [31:0] site);
+        longint unsigned key = {32'(stack_node), site};
+        if (!node_child.exists(key)) begin
+            node_child[key] = node_parent.size();
+            node_parent.push_back(stack_node);
+            node_site.push_back(site);
+        end
+        stack_node = node_child[key];
+        call_stack.push_back(site);
+        node_stack.push_back(stack_node);
+    endfunction
+
+    function automatic void pop_calls(int depth);
+        while (call_stack.size() > depth) begin
+            void'(call_stack.pop_back());
+            void'(node_stack.pop_back());
+        end
+        stack_node = (depth == 0) ? 0 : node_stack[depth - 1];
+    endfunction
+
+    function automatic void resolve_redirect(logic [31:0] destination);
+        case (pending)
+            CALL_DIRECT, CALL_INDIRECT: begin
+                // a direct call to somewhere else was a wrong-path fetch, an indirect call that
+                // was followed by more sequential fetches was behind the jump that redirected
+                if ((pending == CALL_DIRECT && destination == pending_dest) ||
+                    (pending == CALL_INDIRECT && last_pc - pending_pc <= 4 * REDIRECT_SHADOW)) begin
+                    call_count[{pending_pc, destination}]++;
+                    if (call_stack.size() < MAX_DEPTH) begin
+                        push_call(pending_pc);
+                    end
+                end
+            end
+            RETURN: begin
+                // unwind to the matching call site
+                for (int i = call_stack.size() - 1; i >= 0; i--) begin
+                    if (destination == call_stack[i] + 4) begin
+                        pop_calls(i);
+                        break;
+                    end
+                end
+            end
+            default: ;
+        endcase
+        pending = NONE;
+    endfunction
+
+    function automatic void track_instruction(logic [31:0] address, logic [31:0] word);
+        // non-sequential fetch: jump, branch, trap or return
+        if (address != last_pc + 4) begin
+            resolve_redirect(address);
+        end
+        last_pc = address;
+
+        // the first control transfer after a redirect is the one that decides
+        if (pending != NONE) begin
+            return;
+        end
+        if (word[6:0] == OPCODE_JAL && word[11:7] == REG_RA) begin
+            pending      = CALL_DIRECT;
+            pending_pc   = address;
+            pending_dest = jal_target(address, word);
+        end
+        else if (word[6:0] == OPCODE_JALR && word[11:7] == REG_RA) begin
+            pending      = CALL_INDIRECT;
+            pending_pc   = address;
+        end
+        else if (word[6:0] == OPCODE_JALR && word[11:7] == 0 && word[19:15] == REG_RA) begin
+            pending      = RETURN;
+            pending_pc   = address;
+        end
+    endfunction
+
+    // --------------------------------------------------------------------------------------------
+    // |                                         Sampling                                         |
+    // --------------------------------------------------------------------------------------------
+
+    always @(posedge clk) begin
+        if (enable) begin
+            if (rst) begin
+                pop_calls(0);
+                pending   = NONE;
+                last_pc   = 0;
+                countdown = 0;
+            end
+            else begin
+                if (instruction_valid) begin
+                    current_pc = pc;
+                    track_instruction(pc, instruction);
+                end
+
+                total_cycles++;
+                if (countdown == 0) begin
+                    countdown = period - 1;
+                    total_samples++;
+                    pc_samples[current_pc]++;
+                    if (!instruction_valid) begin
+                        stall_samples[current_pc]++;
+                    end
+                    stack_samples[{32'(stack_node), current_pc}]++;
+                end
+                else begin
+                    countdown--;
+                end
+            end
+        end
+    end
+
+    // --------------------------------------------------------------------------------------------
+    // |                                          Output                                          |
+    // --------------------------------------------------------------------------------------------
+
+    // call sites of a call tree node, outermost first ("site;site;...;")
+    function automatic string node_frames(int unsigned node);
+        string frames = "";
+        while (node != 0) begin
+            frames = $sformatf("%08x;%s", node_site[node], frames);
+            node   = node_parent[node];
+        end
+        return frames;
+    endfunction
+
+    final begin
+        if (enable) begin
+            int file;
+            file = $fopen("profile.txt", "w");
+            $fdisplay(file, "# HaDes-V PC samples (see sim/profile.py)");
+            $fdisplay(file, "period %0d", period);
+            $fdisplay(file, "cycles %0d", total_cycles);
+            $fdisplay(file, "samples %0d", total_samples);
+            foreach (pc_samples[address]) begin
+                $fdisplay(file, "pc %08x %0d %0d", address, pc_samples[address],
+                    stall_samples.exists(address) ? stall_samples[address] : 0);
+            end
+            foreach (call_count[edge_key]) begin
+                $fdisplay(file, "call %08x %08x %0d", edge_key[63:32], edge_key[31:0], call_count[edge_key]);
+            end
+            foreach (stack_samples[key]) begin
+                $fdisplay(file, "stack %s%08x %0d", node_frames(key[63:32]), key[31:0], stack_samples[key]);
+            end
+            $fclose(file);
+            $display("Profile written to profile.txt (%0d samples)", total_samples);
+        end
+    end
+
+endmodule
@@ -0,0 +1,148 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: qspi_flash.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Simulation-only model of a QSPI flash (load an image with +flash=<file>).                    |
+// |                                                                                              |
+// | The image is a word memory file (same format as init.mem) and is placed at IMAGE_OFFSET,     |
+// | all other bytes read as 0xFF (erased). Supported are the commands used by wishbone_flash:    |
+// |     - 0xEB Quad I/O Fast Read: 6 address clocks, 2 mode clocks, 4 dummy clocks, then data    |
+// |       (high nibble first, sequential bytes). Mode bits 0xAx enter the continuous read mode,  |
+// |       the following reads start with the address phase.                                      |
+// |     - 0xFF Mode bit reset (any other command is reported and ignored)                        |
+// | Data is driven after the falling edge of sck, inputs are sampled at the rising edge.         |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module qspi_flash #(
+    parameter int        SIZE         = 4 * 1024 * 1024, // bytes
+    parameter bit [23:0] IMAGE_OFFSET = 24'h30_0000
+)(
+    input  logic       cs_n,
+    input  logic       sck,
+    input  logic [3:0] dq_in,
+    output logic [3:0] dq_out,
+    output logic [3:0] dq_oe
+);
+
+    localparam int IMAGE_WORDS = (SIZE - IMAGE_OFFSET) / 4;
+
+    logic [31:0] memory [SIZE / 4];
+    logic [31:0] image  [IMAGE_WORDS];
+
+    // The addresses in the memory file start at 0, the image is loaded separately and moved
+    initial begin
+        string image_file;
+        for (int i = 0; i < SIZE / 4; i++) begin
+            memory[i] = 32'hFFFF_FFFF;
+        end
+        if ($value$plusargs("flash=%s", image_file)) begin
+            for (int i = 0; i < IMAGE_WORDS; i++) begin
+                image[i] = 32'hFFFF_FFFF;
+            end
+            $readmemh(image_file, image);
+            for (int i = 0; i < IMAGE_WORDS; i++) begin
+                memory[IMAGE_OFFSET / 4 + i] = image[i];
+            end
+        end
+    end
+
+    function automatic logic [7:0] read_byte(logic [23:0] address);
+        return memory[address[23:2] % (SIZE / 4)][address[1:0] * 8 +: 8];
+    endfunction
+
+    // --------------------------------------------------------------------------------------------
+    // |                                         Protocol                                         |
+    // --------------------------------------------------------------------------------------------
+
+    typedef enum {COMMAND, ADDRESS, MODE, DUMMY, DATA, IGNORE} state_t;
+
+    state_t      state      = COMMAND;
+    bit          continuous = 0;
+    int          count      = 0;
+    logic  [7:0] command    = 0;
+    logic  [7:0] mode       = 0;
+    logic [23:0] address    = 0;
+    bit          low_nibble = 0;
+    logic  [7:0] data       = 0;
+
+    initial begin
+        dq_out = 0;
+        dq_oe  = 0;
+    end
+
+    // Deselect: end of the current command
+    always @(posedge cs_n) begin
+        state = continuous ? ADDRESS : COMMAND;
+        count = 0;
+        dq_oe = 0;
+    end
+
+    always @(posedge sck) begin
+        if (!cs_n) begin
+            case (state)
+                COMMAND: begin
+                    command = {command[6:0], dq_in[0]};
+                    count++;
+                    if (count == 8) begin
+                        count = 0;
+                        case (command)
+                            8'hEB: state = ADDRESS;
+                            8'hFF: state = IGNORE;
+                            default: begin
+                                $display("(%6d ps) qspi_flash: unsupported command 0x%02x", $time(), command);
+                                state = IGNORE;
+                            end
+                        endcase
+                    end
+                end
+                ADDRESS: begin
+                    address = {address[19:0], dq_in};
+                    count++;
+                    if (count == 6) begin
+                        count = 0;
+                        state = MODE;
+                    end
+                end
+                MODE: begin
+                    mode = {mode[3:0], dq_in};
+                    count++;
+                    if (count == 2) begin
+                        count      = 0;
+                        continuous = mode[7:4] == 4'hA;
+                        state      = DUMMY;
+                    end
+                end
+                DUMMY: begin
+                    count++;
+                    if (count == 4) begin
+                        count      = 0;
+                        low_nibble = 0;
+                        state      = DATA;
+                    end
+                end
+                default: begin end
+            endcase
+        end
+    end
+
+    always @(negedge sck) begin
+        if (!cs_n && state == DATA) begin
+            data   = read_byte(address);
+            dq_oe  = 4'b1111;
+            dq_out = low_nibble ? data[3:0] : data[7:4];
+            if (low_nibble) begin
+                address = address + 1;
+            end
+            low_nibble = !low_nibble;
+        end
+    end
+
+endmodule
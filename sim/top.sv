@@ -7,7 +7,15 @@
 
 
 
-module top;
+module top #(
+    // Program memory configuration (set by the Makefile via -G)
+    parameter int MEMORY_SIZE_KB = 32,
+    parameter int MEMORY_BANKS   = 1,
+    // Tightly coupled data memory (set by the Makefile via -G, see TCM_ENABLE)
+    parameter bit TCM_ENABLE     = 0,
+    // Number of harts (set by the Makefile via -G, see NUM_CORES)
+    parameter int NUM_CORES      = 1
+);
     import clk_params::*;
 
     integer error_count = 0;
@@ -27,10 +35,21 @@ module top;
     logic        vga_vsync;
     logic        uart_rx_async = 1;
     logic        uart_tx;
+    logic  [3:0] timer_pwm;
+    logic        flash_cs_n;
+    logic        flash_sck;
+    logic  [3:0] flash_dq_out;
+    logic  [3:0] flash_dq_oe;
+    logic  [3:0] flash_dq_in;
     /* verilator lint_on unusedsignal */
     mcu #(
         .CLK_FREQUENCY_MHZ(SYS_CLK_FREQUENCY_MHZ),
-        .UART_BAUD_RATE( int'((SYS_CLK_FREQUENCY_MHZ*1_000_000) / 15) )
+        .UART_BAUD_RATE( int'((SYS_CLK_FREQUENCY_MHZ*1_000_000) / 15) ),
+        .MEMORY_SIZE_KB(MEMORY_SIZE_KB),
+        .MEMORY_BANKS(MEMORY_BANKS),
+        .TCM_ENABLE(TCM_ENABLE),
+        .BUS_MONITOR(1),
+        .NUM_CORES(NUM_CORES)
     ) mcu (
         .clk(clk),
         .clk_mem(~clk),
@@ -46,9 +65,64 @@ module top;
         .vga_hsync(vga_hsync),
         .vga_vsync(vga_vsync),
         .uart_rx_async(uart_rx_async),
-        .uart_tx(uart_tx)
+        .uart_tx(uart_tx),
+        .timer_pwm(timer_pwm),
+        .flash_cs_n(flash_cs_n),
+        .flash_sck(flash_sck),
+        .flash_dq_out(flash_dq_out),
+        .flash_dq_oe(flash_dq_oe),
+        .flash_dq_in(flash_dq_in)
     );
 
+    // QSPI flash (load an image with +flash=<file>, see Makefile XIP=1)
+    logic [3:0] flash_model_dq_out;
+    logic [3:0] flash_model_dq_oe;
+    qspi_flash flash(
+        .cs_n(flash_cs_n),
+        .sck(flash_sck),
+        .dq_in(flash_dq_out),
+        .dq_out(flash_model_dq_out),
+        .dq_oe(flash_model_dq_oe)
+    );
+
+    // Shared dq lines with pull-ups
+    assign flash_dq_in = (flash_dq_out & flash_dq_oe) | (flash_model_dq_out & flash_model_dq_oe)
+                       | ~(flash_dq_oe | flash_model_dq_oe);
+
+    // PC sampling profiler (enable with +profile)
+    profiler profiler(
+        .clk(clk),
+        .rst(mcu.rst),
+        .instruction_valid(mcu.fetch_bus.cyc && mcu.fetch_bus.stb && mcu.fetch_bus.ack),
+        .pc(mcu.fetch_bus.adr << 2),
+        .instruction(mcu.fetch_bus.dat_miso)
+    );
+
+`ifdef PIPELINE_MONITOR
+    // Pipeline statistics (PIPELINE_MONITOR is the path of the stage instances, e.g. mcu.cpu)
+    pipeline_monitor pipeline_monitor(
+        .clk(clk),
+        .rst(mcu.rst),
+        .fetch_request(mcu.fetch_bus.cyc && mcu.fetch_bus.stb),
+        .fetch_ack(mcu.fetch_bus.ack),
+        .fetch_pc(mcu.fetch_bus.adr << 2),
+        .mem_request(mcu.mem_bus.cyc && mcu.mem_bus.stb),
+        .mem_ack(mcu.mem_bus.ack),
+        .decode_status_forwards(`PIPELINE_MONITOR.decode_stage_module.status_forwards_in),
+        .execute_status_forwards(`PIPELINE_MONITOR.execute_stage_module.status_forwards_in),
+        .memory_status_forwards(`PIPELINE_MONITOR.memory_stage_module.status_forwards_in),
+        .writeback_status_forwards(`PIPELINE_MONITOR.writeback_stage_module.status_forwards_in),
+        .decode_status_backwards(`PIPELINE_MONITOR.decode_stage_module.status_backwards_out),
+        .execute_status_backwards(`PIPELINE_MONITOR.execute_stage_module.status_backwards_out),
+        .memory_status_backwards(`PIPELINE_MONITOR.memory_stage_module.status_backwards_out),
+        .writeback_status_backwards(`PIPELINE_MONITOR.writeback_stage_module.status_backwards_out),
+        .decode_pc(`PIPELINE_MONITOR.decode_stage_module.program_counter_in),
+        .execute_pc(`PIPELINE_MONITOR.execute_stage_module.program_counter_in),
+        .memory_pc(`PIPELINE_MONITOR.memory_stage_module.program_counter_in),
+        .writeback_pc(`PIPELINE_MONITOR.writeback_stage_module.program_counter_in)
+    );
+`endif
+
     // System clock
     initial begin
         clk = 1;
@@ -68,19 +142,88 @@ module top;
     end
 
     initial begin
-        $dumpfile("sim.fst");
-        $dumpvars;
+        int max_cycles;
 
-        // Run for 10000 cycles max
-        repeat (100000) @(negedge clk);
+        // Run for 100000 cycles max (override with +timeout=<cycles>)
+        if (!$value$plusargs("timeout=%d", max_cycles)) begin
+            max_cycles = 100000;
+        end
+        repeat (max_cycles) @(negedge clk);
 
         // Stop simulation
         $display("\033[0;33m"); // color_orange
         $display("Simulation timeout!");
         $display("\033[0m"); // color off
+        trace_control(TRACE_FAIL);
         $finish();
     end
 
+    // --------------------------------------------------------------------------------------------
+    // Waveform tracing (the trace file itself is handled by sim/main.cpp)
+    //   +notrace               no waveform (e.g. for long benchmark runs)
+    //   +trace_start=<cycle>   start tracing at the given cycle
+    //   +trace_pc=<hex>        start tracing when the instruction at this address is fetched
+    //   +trace_stop=<cycle>    stop tracing at the given cycle
+    //   +trace_ring=<cycles>   ring buffer: only keep the last <cycles> (up to 2x) before the
+    //                          first failing test (after the initial one) or the timeout
+    //   +trace_post=<cycles>   cycles traced after the failure in ring mode (default 100)
+    //   +trace_depth=<levels>, +trace_scope=<hierarchy>: filters, see sim/main.cpp
+    // Arrays larger than TRACE_MAX_ARRAY (Makefile) are never traced (RAM, VGA memory).
+    typedef enum int {
+        TRACE_START  = 0,
+        TRACE_STOP   = 1,
+        TRACE_ROTATE = 2,
+        TRACE_FAIL   = 3
+    } trace_command_t;
+
+    import "DPI-C" function void trace_control(input int command);
+
+    longint unsigned trace_cycle = 0;
+    longint unsigned trace_start = 0;
+    longint unsigned trace_stop  = 0;
+    longint unsigned trace_ring  = 0;
+    longint unsigned trace_post  = 100;
+    longint unsigned trace_failed_cycle = 0;
+    logic [31:0] trace_pc = 0;
+    bit trace_pc_enable = 0;
+    bit trace_failed    = 0;
+
+    initial begin
+        void'($value$plusargs("trace_start=%d", trace_start));
+        void'($value$plusargs("trace_stop=%d", trace_stop));
+        void'($value$plusargs("trace_ring=%d", trace_ring));
+        void'($value$plusargs("trace_post=%d", trace_post));
+        trace_pc_enable = $value$plusargs("trace_pc=%h", trace_pc);
+        if (trace_start > 0 || trace_pc_enable) begin
+            trace_control(TRACE_STOP);
+        end
+    end
+
+    always @(posedge clk) begin
+        trace_cycle <= trace_cycle + 1;
+
+        // start/stop triggers
+        if (trace_start > 0 && trace_cycle == trace_start) begin
+            trace_control(TRACE_START);
+        end
+        if (trace_pc_enable && mcu.fetch_bus.cyc && mcu.fetch_bus.stb && mcu.fetch_bus.ack
+                && (mcu.fetch_bus.adr << 2) == trace_pc) begin
+            trace_pc_enable = 0;
+            trace_control(TRACE_START);
+        end
+        if (trace_stop > 0 && trace_cycle == trace_stop) begin
+            trace_control(TRACE_STOP);
+        end
+
+        // ring buffer: new segment every trace_ring cycles, stop trace_post cycles after the failure
+        if (trace_ring > 0 && !trace_failed && trace_cycle > 0 && trace_cycle % trace_ring == 0) begin
+            trace_control(TRACE_ROTATE);
+        end
+        if (trace_ring > 0 && trace_failed && trace_cycle == trace_failed_cycle + trace_post) begin
+            trace_control(TRACE_STOP);
+        end
+    end
+
     // Respond to test interface
     always @(posedge clk) begin
         if (mcu.wb_test.test_stb) begin
@@ -89,6 +232,12 @@ module top;
                 1: begin
                     $display("(%6d ps) Test fail!", $time());
                     error_count <= error_count + 1;
+                    // the first test fails on purpose
+                    if (error_count > 0 && !trace_failed) begin
+                        trace_failed       = 1;
+                        trace_failed_cycle = trace_cycle;
+                        trace_control(TRACE_FAIL);
+                    end
                 end
                 2: begin
                     $finish();
@@ -98,8 +247,25 @@ module top;
         end
     end
 
+    // Benchmark reports (key: up to 4 ASCII characters, first character in the lowest byte)
+    always @(posedge clk) begin
+        if (mcu.wb_test.report_stb) begin
+            $display("REPORT %s %0d", report_key_string(mcu.wb_test.report_key), mcu.wb_test.report_value);
+        end
+    end
+
     // --------------------------------------------------------------------------------------------
     // print helper functions
+    function automatic string report_key_string(logic [31:0] key);
+        string result = "";
+        for (int i = 0; i < 4; i++) begin
+            if (key[i*8 +: 8] != 0) begin
+                result = $sformatf("%s%c", result, key[i*8 +: 8]);
+            end
+        end
+        return result;
+    endfunction
+
     function void print_test_done();
         if (error_count == 0) begin
             $display("\033[0;33m"); // color_orange
@@ -0,0 +1,58 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: bench.h
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Benchmark helpers (see test/bench).                                                          |
+// | Cycles and retired instructions are taken from the mcycle/minstret CSRs and reported to the  |
+// | testbench through the report registers of the test peripheral ("REPORT <key> <value>").      |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#include <stdint.h>
+
+#include "peripherals.h"
+
+typedef struct {
+    uint32_t cycles;
+    uint32_t instructions;
+} bench_counter_t;
+
+/* read the lower 32 bit of mcycle/minstret
+*/
+static inline uint32_t readCycles() {
+    uint32_t value;
+    asm volatile("csrr %0, mcycle" : "=r"(value));
+    return value;
+}
+
+static inline uint32_t readInstructions() {
+    uint32_t value;
+    asm volatile("csrr %0, minstret" : "=r"(value));
+    return value;
+}
+
+/* start/stop a measurement, after benchStop the counter holds the difference
+*/
+void benchStart(bench_counter_t *counter);
+void benchStop(bench_counter_t *counter);
+
+/* report a value to the testbench
+    @key: up to 4 characters, e.g. "cycl"
+*/
+void benchReport(const char *key, uint32_t value);
+
+/* report cycles ("cycl") and instructions ("inst") of a measurement
+*/
+void benchReportCounter(const bench_counter_t *counter);
+
+#endif // _BENCH_H
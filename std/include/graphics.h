@@ -0,0 +1,72 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: graphics.h
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Batched drawing functions for the VGA frame buffer (640x480, 4 bit per pixel).               |
+// |                                                                                              |
+// | In contrast to setPixel (one read-modify-write per pixel), every function below touches      |
+// | each frame buffer word (8 pixels) at most once: fully covered words are written directly,    |
+// | partially covered words (span head/tail, sprite edges, transparency) are read once and       |
+// | written once. Everything is clipped to the screen.                                           |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#ifndef _GRAPHICS_H
+#define _GRAPHICS_H
+
+#include <stdint.h>
+
+#include "helperfunctions.h"
+
+// Font: 3x5 pixel glyphs for ASCII 32-95 (lower case letters are drawn as upper case)
+#define FONT_GLYPH_WIDTH    3
+#define FONT_GLYPH_HEIGHT   5
+#define FONT_CHAR_WIDTH     4 // including spacing
+#define FONT_CHAR_HEIGHT    6 // including spacing
+
+// Use as "transparent" / "background" argument to disable transparency / background
+#define GRAPHICS_NO_COLOR   (-1)
+
+// ------------------------------------------------------------------------------------------------
+// |                                      Filled primitives                                       |
+// ------------------------------------------------------------------------------------------------
+
+/* fill the whole screen with color
+*/
+void fillScreen(vga_color_t color);
+
+/* fill width pixels of a row starting at column
+*/
+void fillSpan(int row, int column, int width, vga_color_t color);
+
+/* fill a width x height rectangle with its top left corner at row/column
+*/
+void fillRect(int row, int column, int width, int height, vga_color_t color);
+
+// ------------------------------------------------------------------------------------------------
+// |                                       Sprites / Bitmaps                                      |
+// ------------------------------------------------------------------------------------------------
+
+/* draw a 4 bit per pixel sprite with its top left corner at row/column
+    @sprite: rows of (width + 1) / 2 bytes, lower nibble = left pixel (same as the frame buffer)
+    @transparent: color that is skipped or GRAPHICS_NO_COLOR (opaque bitmap)
+*/
+void drawSprite(int row, int column, const uint8_t *sprite, int width, int height, int transparent);
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Text                                             |
+// ------------------------------------------------------------------------------------------------
+
+/* draw text with its top left corner at row/column ('\n' starts a new line at column)
+    @background: fill color of the character cells or GRAPHICS_NO_COLOR (transparent)
+*/
+void drawText(int row, int column, const char *text, vga_color_t color, int background);
+
+#endif // _GRAPHICS_H
@@ -78,6 +78,35 @@ uint8_t setPixelByte(int px_idx, vga_color_t color);
 uint8_t setPixelHalfword(int px_idx, vga_color_t color);
 uint8_t setPixelWord(int px_idx, vga_color_t color);
 
+// ------------------------------------------------------------------------------------------------
+// |                                         Timer-helpers                                        |
+// ------------------------------------------------------------------------------------------------
+
+/* read the 64 bit machine time (consistent, uses the mtimeh latch of the executing hart)
+    @return: mtime
+*/
+uint64_t readMachineTime();
+
+/* read the 64 bit machine time without the latch (fallback, reads mtimeh before and after mtime,
+   e.g. for a timer without latch register)
+    @return: mtime
+*/
+uint64_t readMachineTimeHiLoHi();
+
+/* raise the timer interrupt every period_cycles cycles (hardware auto-reload)
+   the interrupt handler only has to call clearTimerPending(1<<TIMER_PENDING_IDX_MTIME)
+*/
+void setupPeriodicTimer(uint32_t period_cycles);
+
+/* configure and start a compare channel
+    @ctrl: TIMER_CH_CTRL_IDX_* bits and output mode, the enable bit is set by this function
+*/
+void setupTimerChannel(uint8_t channel, uint32_t period_cycles, uint32_t compare, uint32_t ctrl);
+
+/* acknowledge timer events (write 1 to clear)
+*/
+void clearTimerPending(uint32_t mask);
+
 // ------------------------------------------------------------------------------------------------
 // |                                       Interrupt-helpers                                      |
 // ------------------------------------------------------------------------------------------------
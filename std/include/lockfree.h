@@ -0,0 +1,138 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: lockfree.h
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Data exchange between main and interrupt handlers without disabling interrupts.              |
+// |                                                                                              |
+// | Aligned word loads/stores are atomic and the interrupt handler is never interrupted itself.  |
+// | Every shared word below is written by one side only, so the other side never sees a torn     |
+// | update and no read-modify-write has to be protected:                                         |
+// |     - queue_t: single producer / single consumer byte queue (e.g. UART TX from main to ISR)  |
+// |     - event_t: event counter, the ISR signals, main takes all events since the last take     |
+// | For everything else, interruptsSave/interruptsRestore are a one instruction critical section |
+// | each (instead of read-modify-write of mstatus).                                              |
+// |                                                                                              |
+// | Multi-core mcu (NUM_CORES > 1, see multicore.h): queue_t and event_t also work between two   |
+// | harts (one producer hart, one consumer hart), since the harts are in-order and their stores  |
+// | reach the shared RAM in program order. They must be placed in RAM, not in the TCM or local   |
+// | memory (every hart has its own). interruptsSave/interruptsRestore only mask the interrupts   |
+// | of the executing hart, they are no critical section against the other harts.                 |
+// |                                                                                              |
+// | Usage:                                                                                       |
+// |     QUEUE_DEFINE(tx_queue, 64);           // size must be a power of 2                       |
+// |     queuePush(&tx_queue, 'a');            // main                                            |
+// |     if (queuePop(&tx_queue, &c)) ...      // interrupt handler                               |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#ifndef _LOCKFREE_H
+#define _LOCKFREE_H
+
+#include <stdint.h>
+
+// Keeps the compiler from moving memory accesses across (the core itself executes them in order)
+#define LOCKFREE_BARRIER() asm volatile("" ::: "memory")
+
+// ------------------------------------------------------------------------------------------------
+// |                                       Critical section                                       |
+// ------------------------------------------------------------------------------------------------
+
+/* disable machine interrupts
+    @return: previous state, pass to interruptsRestore
+*/
+static inline uint32_t interruptsSave() {
+    uint32_t mstatus;
+    asm volatile("csrrci %0, mstatus, 8" : "=r"(mstatus) : : "memory"); // MSTATUS_MIE
+    return mstatus & (1<<3);
+}
+
+/* re-enable machine interrupts if they were enabled before interruptsSave
+*/
+static inline void interruptsRestore(uint32_t state) {
+    asm volatile("csrs mstatus, %0" : : "r"(state) : "memory");
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Queue                                             |
+// ------------------------------------------------------------------------------------------------
+
+typedef struct {
+    volatile uint32_t head;     // written by the producer only (free running)
+    volatile uint32_t tail;     // written by the consumer only (free running)
+    uint32_t          mask;     // size - 1
+    volatile uint8_t *data;
+} queue_t;
+
+// define and initialize a queue with size (power of 2) bytes
+#define QUEUE_DEFINE(name, size) \
+    static volatile uint8_t name##_data[size]; \
+    queue_t name = { 0, 0, (size) - 1, name##_data }
+
+/* number of bytes in the queue (exact for the consumer, at most for the producer)
+*/
+static inline uint32_t queueCount(const queue_t *queue) {
+    return queue->head - queue->tail;
+}
+
+/* add a byte (producer only)
+    @return: 1 on success, 0 if the queue is full
+*/
+static inline int queuePush(queue_t *queue, uint8_t value) {
+    uint32_t head = queue->head;
+    if (head - queue->tail > queue->mask) {
+        return 0;
+    }
+    queue->data[head & queue->mask] = value;
+    // publish the data before the index
+    LOCKFREE_BARRIER();
+    queue->head = head + 1;
+    return 1;
+}
+
+/* remove the oldest byte (consumer only)
+    @return: 1 on success, 0 if the queue is empty
+*/
+static inline int queuePop(queue_t *queue, uint8_t *value) {
+    uint32_t tail = queue->tail;
+    if (tail == queue->head) {
+        return 0;
+    }
+    *value = queue->data[tail & queue->mask];
+    // read the data before releasing the slot
+    LOCKFREE_BARRIER();
+    queue->tail = tail + 1;
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Events                                            |
+// ------------------------------------------------------------------------------------------------
+
+typedef struct {
+    volatile uint32_t signaled; // written by the interrupt handler only
+    uint32_t          taken;    // written by main only
+} event_t;
+
+/* count an event (interrupt handler)
+*/
+static inline void eventSignal(event_t *event) {
+    event->signaled = event->signaled + 1;
+}
+
+/* events signaled since the last call (main)
+*/
+static inline uint32_t eventTake(event_t *event) {
+    uint32_t signaled = event->signaled;
+    uint32_t count = signaled - event->taken;
+    event->taken = signaled;
+    return count;
+}
+
+#endif // _LOCKFREE_H
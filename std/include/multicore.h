@@ -0,0 +1,109 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: multicore.h
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Multi-core mcu (mcu parameter NUM_CORES, make NUM_CORES=n).                                  |
+// |                                                                                              |
+// | Hart 0 runs main() as before. If the program defines hart_main(), __start of hart 0 starts   |
+// | all other harts after .data/.bss are initialized; they run hart_main(hart) and are stopped   |
+// | when it returns. Every hart has its own stack and .tcm/.tcm_bss (TCM at the same address),   |
+// | RAM, peripherals and the flash are shared. mhartid reads 0 on every hart, use hartId().      |
+// | Only hart 0 takes timer interrupts (mtimecmp), the other harts only get ipiSend interrupts.  |
+// |                                                                                              |
+// | The harts 1 ... NUM_HARTS - 1 additionally have a local memory for code and data (__local,   |
+// | copied by __start of every hart). Code in RAM is fetched through the shared bus, so hot code |
+// | of these harts belongs into the local memory. Hart 0 has no local memory: __local functions  |
+// | must not be called from main(). Programs running from the flash (XIP) can't use the other    |
+// | harts, they start at the reset address in RAM (bootloader).                                  |
+// |                                                                                              |
+// | There are no atomic instructions. Aligned word accesses are atomic, words shared between     |
+// | harts should be written by one hart only (see lockfree.h), or use the message registers.     |
+// |                                                                                              |
+// | Usage:                                                                                       |
+// |     __local void hart_main(uint32_t hart) { ... }  // entry point of the harts 1 ... n - 1   |
+// |     __local_data uint32_t table[16] = {1, 2, 3};   // data in the local memory of each hart  |
+// |     ipiSend(0);                                    // external interrupt of hart 0           |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#ifndef _MULTICORE_H
+#define _MULTICORE_H
+
+#include <stdint.h>
+
+#include "peripherals.h"
+
+#define __local      __attribute__((section(".local.text")))
+#define __local_data __attribute__((section(".local.data")))
+
+/* entry point of the harts 1 ... NUM_HARTS - 1 (optional, defined by the program)
+    @hart: index of the hart
+*/
+void hart_main(uint32_t hart);
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Harts                                             |
+// ------------------------------------------------------------------------------------------------
+
+/* index of the executing hart
+*/
+static inline uint32_t hartId() {
+    return *MAILBOX_HARTID_ADDRESS;
+}
+
+/* number of harts of the mcu
+*/
+static inline uint32_t numHarts() {
+    return *MAILBOX_NUM_HARTS_ADDRESS;
+}
+
+/* running harts (bit n: hart n)
+*/
+static inline uint32_t hartsRunning() {
+    return *MAILBOX_RUN_ADDRESS;
+}
+
+/* start harts at the reset address (__start calls hart_main again)
+    @harts: bit n: hart n
+*/
+static inline void hartsStart(uint32_t harts) {
+    *MAILBOX_RUN_ADDRESS = harts;
+}
+
+/* stop harts (held in reset, hart 0 can't be stopped)
+    @harts: bit n: hart n
+*/
+static inline void hartsStop(uint32_t harts) {
+    *MAILBOX_HALT_ADDRESS = harts;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                  Inter-processor interrupts                                  |
+// ------------------------------------------------------------------------------------------------
+
+/* raise the external interrupt of a hart (pending until cleared by ipiClear)
+*/
+static inline void ipiSend(uint32_t hart) {
+    *MAILBOX_IPI_ADDRESS = 1 << hart;
+}
+
+/* clear the pending inter-processor interrupt of a hart (e.g. in its interrupt handler)
+*/
+static inline void ipiClear(uint32_t hart) {
+    *MAILBOX_IPI_CLEAR_ADDRESS = 1 << hart;
+}
+
+/* pending inter-processor interrupts (bit n: hart n)
+*/
+static inline uint32_t ipiPending() {
+    return *MAILBOX_IPI_ADDRESS;
+}
+
+#endif // _MULTICORE_H
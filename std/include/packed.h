@@ -0,0 +1,163 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: packed.h
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Packed operations on 8 nibbles (4 bit pixels, same layout as the frame buffer: nibble 0 is   |
+// | the left pixel) or 4 bytes of a word. Every lane is processed at once with a few RV32I       |
+// | instructions (no loops, no multiplication, no carries across lanes).                         |
+// |                                                                                              |
+// | Masks returned by the *Mask functions have all bits of a lane set (0xF / 0xFF) or cleared,   |
+// | they can be used with nibbleSelect/byteSelect or directly as frame buffer write mask.        |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#ifndef _PACKED_H
+#define _PACKED_H
+
+#include <stdint.h>
+
+#define PACKED_NIBBLE_LOW   0x11111111u
+#define PACKED_BYTE_LOW     0x01010101u
+#define PACKED_BYTE_HIGH    0x80808080u
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Nibbles                                            |
+// ------------------------------------------------------------------------------------------------
+
+/* replicate the lower 4 bits of value into all 8 nibbles
+*/
+static inline uint32_t nibbleBroadcast(uint32_t value) {
+    value &= 0xF;
+    value |= value << 4;
+    value |= value << 8;
+    value |= value << 16;
+    return value;
+}
+
+/* nibble index (0-7) of word
+*/
+static inline uint32_t nibbleExtract(uint32_t word, int index) {
+    return (word >> (index << 2)) & 0xF;
+}
+
+/* replace nibble index (0-7) of word by the lower 4 bits of value
+*/
+static inline uint32_t nibbleInsert(uint32_t word, int index, uint32_t value) {
+    int shift = index << 2;
+    return (word & ~(0xFu << shift)) | ((value & 0xF) << shift);
+}
+
+/* 0xF in every nibble where a and b are equal, 0x0 otherwise
+*/
+static inline uint32_t nibbleEqualMask(uint32_t a, uint32_t b) {
+    uint32_t diff = a ^ b;
+    // or all bits of a nibble into its lowest bit
+    diff |= diff >> 1;
+    diff |= diff >> 2;
+    uint32_t equal = ~diff & PACKED_NIBBLE_LOW;
+    // 0x1 -> 0xF per nibble (the carry out of the top nibble is dropped)
+    return (equal << 4) - equal;
+}
+
+/* nibbles of a where mask is set, nibbles of b otherwise
+*/
+static inline uint32_t nibbleSelect(uint32_t mask, uint32_t a, uint32_t b) {
+    return (a & mask) | (b & ~mask);
+}
+
+/* draw src over dst, nibbles of src equal to color are transparent
+*/
+static inline uint32_t nibbleBlend(uint32_t dst, uint32_t src, uint32_t color) {
+    return nibbleSelect(nibbleEqualMask(src, nibbleBroadcast(color)), dst, src);
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Bytes                                             |
+// ------------------------------------------------------------------------------------------------
+
+/* replicate the lower 8 bits of value into all 4 bytes
+*/
+static inline uint32_t byteBroadcast(uint32_t value) {
+    value &= 0xFF;
+    value |= value << 8;
+    value |= value << 16;
+    return value;
+}
+
+/* bytes of a where mask is set, bytes of b otherwise
+*/
+static inline uint32_t byteSelect(uint32_t mask, uint32_t a, uint32_t b) {
+    return (a & mask) | (b & ~mask);
+}
+
+/* expand the highest bit of every byte to the whole byte (the carry out of the top byte is dropped)
+*/
+static inline uint32_t byteExpandHigh(uint32_t high) {
+    high &= PACKED_BYTE_HIGH;
+    return (high << 1) - (high >> 7);
+}
+
+/* a + b per byte (wrapping)
+*/
+static inline uint32_t byteAdd(uint32_t a, uint32_t b) {
+    return ((a & ~PACKED_BYTE_HIGH) + (b & ~PACKED_BYTE_HIGH)) ^ ((a ^ b) & PACKED_BYTE_HIGH);
+}
+
+/* a - b per byte (wrapping)
+*/
+static inline uint32_t byteSub(uint32_t a, uint32_t b) {
+    return ((a | PACKED_BYTE_HIGH) - (b & ~PACKED_BYTE_HIGH)) ^ ((a ^ ~b) & PACKED_BYTE_HIGH);
+}
+
+/* a + b per byte, unsigned saturating (0xFF on overflow)
+*/
+static inline uint32_t byteAddSaturate(uint32_t a, uint32_t b) {
+    uint32_t sum = byteAdd(a, b);
+    // carry out of every byte
+    uint32_t carry = (a & b) | ((a | b) & ~sum);
+    return sum | byteExpandHigh(carry);
+}
+
+/* a - b per byte, unsigned saturating (0x00 on underflow)
+*/
+static inline uint32_t byteSubSaturate(uint32_t a, uint32_t b) {
+    uint32_t diff = byteSub(a, b);
+    // borrow out of every byte
+    uint32_t borrow = (~a & b) | (~(a ^ b) & diff);
+    return diff & ~byteExpandHigh(borrow);
+}
+
+/* 0xFF in every byte where a < b (unsigned), 0x00 otherwise
+*/
+static inline uint32_t byteLessMask(uint32_t a, uint32_t b) {
+    uint32_t diff = byteSub(a, b);
+    return byteExpandHigh((~a & b) | (~(a ^ b) & diff));
+}
+
+/* 0xFF in every byte where a and b are equal, 0x00 otherwise
+*/
+static inline uint32_t byteEqualMask(uint32_t a, uint32_t b) {
+    uint32_t diff = a ^ b;
+    // set the highest bit of every non-zero byte
+    uint32_t nonzero = ((diff & ~PACKED_BYTE_HIGH) + ~PACKED_BYTE_HIGH) | diff;
+    return ~byteExpandHigh(nonzero);
+}
+
+/* unsigned minimum/maximum per byte
+*/
+static inline uint32_t byteMin(uint32_t a, uint32_t b) {
+    return byteSelect(byteLessMask(a, b), a, b);
+}
+
+static inline uint32_t byteMax(uint32_t a, uint32_t b) {
+    return byteSelect(byteLessMask(a, b), b, a);
+}
+
+#endif // _PACKED_H
@@ -18,7 +18,18 @@
 
 #include <stdint.h>
 
+// Program memory size in KB (passed by the Makefile, must match the mcu parameter MEMORY_SIZE_KB)
+#ifndef MEMORY_SIZE_KB
+#define MEMORY_SIZE_KB 32
+#endif
+
 // ADDRESSES
+#define LOCAL_ADDRESS                 (((volatile uint32_t *) ((0x00008000    ) << 2)))
+#define LOCAL_SIZE                    (0x00000400 << 2)
+#define MEMORY_ADDRESS                (((volatile uint32_t *) ((0x00010000    ) << 2)))
+#define MEMORY_SIZE                   (MEMORY_SIZE_KB * 1024)
+#define TCM_ADDRESS                   (((volatile uint32_t *) ((0x00020000    ) << 2)))
+#define TCM_SIZE                      (0x00000400 << 2)
 #define LEDS_ADDRESS                  (((volatile uint16_t *) ((0x00080000    ) << 2)))
 #define BUTTONS_ADDRESS               (((volatile uint8_t  *) ((0x00081000    ) << 2)))
 #define SWITCHES_ADDRESS              (((volatile uint16_t *) ((0x00082000    ) << 2)))
@@ -32,11 +43,41 @@
 #define TIMER_MTIMEH_ADDRESS          (((volatile uint32_t *) ((0x00085000 + 2) << 2)))
 #define TIMER_MTIMECMP_ADDRESS        (((volatile uint32_t *) ((0x00085000 + 3) << 2)))
 #define TIMER_MTIMECMPH_ADDRESS       (((volatile uint32_t *) ((0x00085000 + 4) << 2)))
+#define TIMER_MTIMECTRL_ADDRESS       (((volatile uint32_t *) ((0x00085000 + 5) << 2)))
+#define TIMER_MTIMEPERIOD_ADDRESS     (((volatile uint32_t *) ((0x00085000 + 6) << 2)))
+#define TIMER_PENDING_ADDRESS         (((volatile uint32_t *) ((0x00085000 + 7) << 2)))
+#define TIMER_CH_CTRL_ADDRESS(n)      (((volatile uint32_t *) ((0x00085000 + 8 + 4 * (n)) << 2)))
+#define TIMER_CH_PERIOD_ADDRESS(n)    (((volatile uint32_t *) ((0x00085000 + 9 + 4 * (n)) << 2)))
+#define TIMER_CH_COMPARE_ADDRESS(n)   (((volatile uint32_t *) ((0x00085000 + 10 + 4 * (n)) << 2)))
+#define TIMER_CH_COUNTER_ADDRESS(n)   (((volatile uint32_t *) ((0x00085000 + 11 + 4 * (n)) << 2)))
+#define TIMER_MTIMEH_LATCHED_ADDRESS  (((volatile uint32_t *) ((0x00085000 + 24) << 2)))
+#define BUS_MONITOR_CTRL_ADDRESS      (((volatile uint32_t *) ((0x00086000    ) << 2)))
+#define BUS_MONITOR_INFO_ADDRESS      (((volatile uint32_t *) ((0x00086000 + 1) << 2)))
+#define BUS_MONITOR_CYCLES_ADDRESS    (((volatile uint32_t *) ((0x00086000 + 2) << 2)))
+#define BUS_MONITOR_BUSY_ADDRESS      (((volatile uint32_t *) ((0x00086000 + 3) << 2)))
+#define BUS_MONITOR_SLAVE_ADDRESS(n)  (((volatile uint32_t *) ((0x00086000 + 16 * ((n) + 1)) << 2)))
+#define MAILBOX_HARTID_ADDRESS        (((volatile uint32_t *) ((0x00087000    ) << 2)))
+#define MAILBOX_NUM_HARTS_ADDRESS     (((volatile uint32_t *) ((0x00087000 + 1) << 2)))
+#define MAILBOX_RUN_ADDRESS           (((volatile uint32_t *) ((0x00087000 + 2) << 2)))
+#define MAILBOX_HALT_ADDRESS          (((volatile uint32_t *) ((0x00087000 + 3) << 2)))
+#define MAILBOX_IPI_ADDRESS           (((volatile uint32_t *) ((0x00087000 + 4) << 2)))
+#define MAILBOX_IPI_CLEAR_ADDRESS     (((volatile uint32_t *) ((0x00087000 + 5) << 2)))
+#define MAILBOX_MESSAGE_ADDRESS(n)    (((volatile uint32_t *) ((0x00087000 + 8 + (n)) << 2)))
 #define VGA_START_ADDRESS             (((volatile uint32_t *) ((0x00090000    ) << 2)))
 #define VGA_START_BYTE_ADDRESS        (((volatile uint8_t  *) ((0x00090000    ) << 2)))
 #define VGA_START_HALFWORD_ADDRESS    (((volatile uint16_t *) ((0x00090000    ) << 2)))
 #define VGA_START_WORD_ADDRESS        (((volatile uint32_t *) ((0x00090000    ) << 2)))
 #define TEST_ADDRESS                  (((volatile uint32_t *) ((0x00120000    ) << 2)))
+#define TEST_INTERRUPT_ADDRESS        (((volatile uint32_t *) ((0x00120000 + 1) << 2)))
+#define TEST_REPORT_KEY_ADDRESS       (((volatile uint32_t *) ((0x00120000 + 5) << 2)))
+#define TEST_REPORT_VALUE_ADDRESS     (((volatile uint32_t *) ((0x00120000 + 6) << 2)))
+#define FLASH_ADDRESS                 (((volatile uint32_t *) ((0x00200000    ) << 2)))
+#define FLASH_SIZE                    (0x00040000 << 2)
+
+// FLASH IMAGE HEADER (execute-in-place, see hades-v.ld.in)
+#define FLASH_IMAGE_MAGIC      0x50495848 // "HXIP"
+#define FLASH_IMAGE_IDX_MAGIC  0
+#define FLASH_IMAGE_IDX_ENTRY  1
 
 // BUTTONS BIT INDICES
 #define BUTTON_CENTER_IDX  0
@@ -53,4 +94,34 @@
 #define UART_TX_STATUS_IDX_IE     1
 #define UART_TX_STATUS_IDX_EMPTY  2
 
+// TIMER BIT INDICES
+// Note: reading TIMER_MTIME latches the upper half for the reading hart in TIMER_MTIMEH_LATCHED
+#define TIMER_STATUS_IDX_NS_PER_CYCLE   0
+#define TIMER_STATUS_IDX_NUM_CHANNELS   8
+#define TIMER_MTIMECTRL_IDX_PERIODIC    0
+#define TIMER_PENDING_IDX_MTIME         0
+#define TIMER_PENDING_IDX_RELOAD(n)     (1 + 2 * (n))
+#define TIMER_PENDING_IDX_COMPARE(n)    (2 + 2 * (n))
+#define TIMER_CH_CTRL_IDX_ENABLE        0
+#define TIMER_CH_CTRL_IDX_RELOAD_IE     1
+#define TIMER_CH_CTRL_IDX_COMPARE_IE    2
+#define TIMER_CH_CTRL_IDX_ONESHOT       3
+#define TIMER_CH_CTRL_IDX_OUTPUT        4
+
+// TIMER CHANNEL OUTPUT MODES
+#define TIMER_CH_OUTPUT_LOW      0
+#define TIMER_CH_OUTPUT_PWM      1
+#define TIMER_CH_OUTPUT_TOGGLE   2
+#define TIMER_CH_OUTPUT_HIGH     3
+
+// BUS MONITOR
+// Slave n: index in the interconnect (0: memory, 1: leds, ... 9: bus monitor, 10: flash, 11: mailbox)
+#define BUS_MONITOR_CTRL_IDX_ENABLE      0
+#define BUS_MONITOR_CTRL_IDX_CLEAR       1
+#define BUS_MONITOR_SLAVE_READS          0
+#define BUS_MONITOR_SLAVE_WRITES         1
+#define BUS_MONITOR_SLAVE_ERRORS         2
+#define BUS_MONITOR_SLAVE_LATENCY        3
+#define BUS_MONITOR_SLAVE_HISTOGRAM(bin) (4 + (bin))
+
 #endif //_PERIPHERALS_H
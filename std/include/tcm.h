@@ -0,0 +1,37 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: tcm.h
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Placement attributes for the tightly coupled data memory (TCM).                              |
+// | Loads and stores to the TCM bypass the peripheral bus and never wait.                        |
+// | The TCM holds data only (no code) and is shared with the stack (see hades-v.ld).             |
+// |                                                                                              |
+// | The TCM is opt-in (make TCM_ENABLE=1, always on with NUM_CORES > 1). Without it, __tcm and   |
+// | __tcm_bss data is placed in RAM and the stack starts at the end of RAM, as before.           |
+// |                                                                                              |
+// | With the TCM, the stack takes the last STACK_SIZE bytes of its 4 KB (default 2 KB, make      |
+// | STACK_SIZE=n or -DSTACK_SIZE=n for the linker script), .tcm/.tcm_bss the rest. The linker    |
+// | fails if they don't fit, but there is no guard at run time: a deeper stack silently          |
+// | overwrites .tcm_bss and .tcm. Programs with deep recursion or large local arrays need a      |
+// | larger STACK_SIZE or the default TCM_ENABLE=0.                                               |
+// |                                                                                              |
+// | Usage:                                                                                       |
+// |     __tcm     uint32_t lookup[16] = {1, 2, 3};  // initialized, copied by __start            |
+// |     __tcm_bss uint8_t  buffer[512];             // zero initialized by __start               |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#ifndef _TCM_H
+#define _TCM_H
+
+#define __tcm     __attribute__((section(".tcm.data")))
+#define __tcm_bss __attribute__((section(".tcm.bss")))
+
+#endif
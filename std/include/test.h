@@ -0,0 +1,33 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: test.h
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Helpers of the c tests (see test/c).                                                         |
+// | check() reports a result to the test peripheral (0: passed, 1: failed). Cycle counts of      |
+// | measurements inside a test use readCycles() of bench.h (mcycle), like the benchmarks.        |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#ifndef _TEST_H
+#define _TEST_H
+
+#include <stdint.h>
+
+#include "peripherals.h"
+#include "bench.h"
+
+/* report a test result to the test peripheral
+    @condition: 0: failed, otherwise passed
+*/
+static inline void check(int condition) {
+    *TEST_ADDRESS = condition ? 0 : 1;
+}
+
+#endif // _TEST_H
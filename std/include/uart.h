@@ -0,0 +1,54 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: uart.h
+ */
+
+
+
+#ifndef _UART_H
+#define _UART_H
+
+#include <stdint.h>
+
+#include "peripherals.h"
+
+// ------------------------------------------------------------------------------------------------
+// |                                        Number-helpers                                        |
+// ------------------------------------------------------------------------------------------------
+
+// buffer size that fits every 32 bit number in any base >= 10 (sign + digits + '\0')
+#define NUMBER_STRING_SIZE 12
+
+/* convert an unsigned number to a string (base 10 or 16, no allocation, no division)
+    @buffer: at least NUMBER_STRING_SIZE characters
+    @return: number of characters written (without '\0')
+*/
+int uint2str(uint32_t value, char *buffer, uint32_t base);
+
+/* convert a signed number to a decimal string
+    @buffer: at least NUMBER_STRING_SIZE characters
+    @return: number of characters written (without '\0')
+*/
+int int2str(int32_t value, char *buffer);
+
+// ------------------------------------------------------------------------------------------------
+// |                                         UART-output                                          |
+// ------------------------------------------------------------------------------------------------
+
+/* send one character (blocks until the transmit buffer is empty)
+*/
+void uartPutChar(char c);
+
+/* send a '\0' terminated string
+*/
+void uartPutString(const char *str);
+
+/* formatted output over the UART (subset of printf, no allocation)
+   supported: %c %s %d %i %u %x %X %p %%, flags '-' and '0', field width (e.g. %08x)
+    @return: number of characters sent
+*/
+int uartPrintf(const char *format, ...);
+
+#endif // _UART_H
@@ -0,0 +1,43 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: bench.c
+ */
+
+
+
+#include "bench.h"
+
+// ------------------------------------------------------------------------------------------------
+// |                                          Measurement                                         |
+// ------------------------------------------------------------------------------------------------
+void benchStart(bench_counter_t *counter) {
+    counter->instructions = readInstructions();
+    counter->cycles       = readCycles();
+}
+
+void benchStop(bench_counter_t *counter) {
+    uint32_t cycles       = readCycles();
+    uint32_t instructions = readInstructions();
+    counter->cycles       = cycles - counter->cycles;
+    counter->instructions = instructions - counter->instructions;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Reporting                                          |
+// ------------------------------------------------------------------------------------------------
+void benchReport(const char *key, uint32_t value) {
+    // pack up to 4 characters, first character in the lowest byte
+    uint32_t packed = 0;
+    for (int i = 0; i < 4 && key[i]; i++) {
+        packed |= (uint32_t)(uint8_t) key[i] << (i << 3);
+    }
+    *TEST_REPORT_KEY_ADDRESS   = packed;
+    *TEST_REPORT_VALUE_ADDRESS = value;
+}
+
+void benchReportCounter(const bench_counter_t *counter) {
+    benchReport("cycl", counter->cycles);
+    benchReport("inst", counter->instructions);
+}
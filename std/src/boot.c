@@ -14,12 +14,14 @@
 // |                                                                                              |
 // ------------------------------------------------------------------------------------------------
 
-#include <string.h>
+#include <stdint.h>
+
+#include "peripherals.h"
 
 __attribute__((naked))
 void __reset_bootloader_stack() {
     // Reset the stack pointer
-    asm("la sp, __ram_end");
+    asm("la sp, __stack_top");
 
     // Return to c code
     asm("j __copy_bootloader");
@@ -32,6 +34,12 @@ extern char __boot_load;
 extern void __bootloader();
 
 void run_bootloader() {
+    // Start the execute-in-place image in the flash (if any), hold the south button to upload instead
+    if (FLASH_ADDRESS[FLASH_IMAGE_IDX_MAGIC] == FLASH_IMAGE_MAGIC && !(*BUTTONS_ADDRESS & (1 << BUTTON_SOUTH_IDX))) {
+        void (* entry)() = (void (*)()) FLASH_ADDRESS[FLASH_IMAGE_IDX_ENTRY];
+        entry();
+    }
+
     // Disable all interrupts
     asm("csrw mie, x0");
 
@@ -39,14 +47,19 @@ void run_bootloader() {
 }
 
 void __copy_bootloader() {
-    // Copy from the LMA to the VMA
-    char *source = &__boot_load;
-    char *dest = &__boot_start;
-
-    while (dest < &__boot_end) {
-        *dest = *source;
-        dest++;
-        source++;
+    // Copy from the LMA to the VMA (4 words per iteration, .boot is padded to 16 bytes)
+    // Note: memcpy can't be used, it may be overwritten by the new program
+    uint32_t *source = (uint32_t *) &__boot_load;
+    uint32_t *dest = (uint32_t *) &__boot_start;
+    uint32_t *end = (uint32_t *) &__boot_end;
+
+    while (dest < end) {
+        dest[0] = source[0];
+        dest[1] = source[1];
+        dest[2] = source[2];
+        dest[3] = source[3];
+        dest += 4;
+        source += 4;
     }
 
     while (1) {
@@ -0,0 +1,231 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: graphics.c
+ */
+
+
+
+#include "graphics.h"
+#include "packed.h"
+
+#define PIXELS_PER_WORD     8
+#define WORDS_PER_ROW       (VGA_SCREEN_WIDTH / PIXELS_PER_WORD)
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Helpers                                           |
+// ------------------------------------------------------------------------------------------------
+
+// mask of the pixels first...last (inclusive) within a word
+static inline uint32_t pixelMask(int first, int last) {
+    uint32_t high = (last == PIXELS_PER_WORD - 1) ? 0xFFFFFFFF : (1u << ((last + 1) << 2)) - 1;
+    uint32_t low  = (1u << (first << 2)) - 1;
+    return high & ~low;
+}
+
+// write the masked part of data to a frame buffer word (plain store if fully covered)
+static inline void writeWord(volatile uint32_t *word, uint32_t data, uint32_t mask) {
+    if (mask == 0xFFFFFFFF) {
+        *word = data;
+    }
+    else if (mask != 0) {
+        *word = (*word & ~mask) | (data & mask);
+    }
+}
+
+// Collects single pixels of one row and writes every frame buffer word once
+typedef struct {
+    volatile uint32_t *word;
+    uint32_t data;
+    uint32_t mask;
+} pixel_batch_t;
+
+static inline void batchStart(pixel_batch_t *batch) {
+    batch->word = 0;
+    batch->data = 0;
+    batch->mask = 0;
+}
+
+static inline void batchFlush(pixel_batch_t *batch) {
+    writeWord(batch->word, batch->data, batch->mask);
+    batch->data = 0;
+    batch->mask = 0;
+}
+
+// pixels must be added from left to right (clipped by the caller)
+static inline void batchPixel(pixel_batch_t *batch, int row, int column, uint32_t color) {
+    volatile uint32_t *word = VGA_START_WORD_ADDRESS + row * WORDS_PER_ROW + (column >> 3);
+    if (word != batch->word) {
+        batchFlush(batch);
+        batch->word = word;
+    }
+    int shift = (column & 0b111) << 2;
+    batch->data |= color << shift;
+    batch->mask |= 0xF << shift;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                      Filled primitives                                       |
+// ------------------------------------------------------------------------------------------------
+void fillScreen(vga_color_t color) {
+    fillRect(0, 0, VGA_SCREEN_WIDTH, VGA_SCREEN_HEIGHT, color);
+}
+
+void fillSpan(int row, int column, int width, vga_color_t color) {
+    fillRect(row, column, width, 1, color);
+}
+
+void fillRect(int row, int column, int width, int height, vga_color_t color) {
+    // clip
+    if (column < 0) { width  += column; column = 0; }
+    if (row    < 0) { height += row;    row    = 0; }
+    if (column + width  > VGA_SCREEN_WIDTH)  { width  = VGA_SCREEN_WIDTH  - column; }
+    if (row    + height > VGA_SCREEN_HEIGHT) { height = VGA_SCREEN_HEIGHT - row;    }
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    uint32_t data = nibbleBroadcast(color);
+    int last_column = column + width - 1;
+    int first_word  = column >> 3;
+    int last_word   = last_column >> 3;
+
+    // masks of the (partially covered) head and tail word
+    uint32_t head_mask = pixelMask(column & 0b111, (first_word == last_word) ? (last_column & 0b111) : 7);
+    uint32_t tail_mask = pixelMask(0, last_column & 0b111);
+
+    volatile uint32_t *line = VGA_START_WORD_ADDRESS + row * WORDS_PER_ROW;
+    for (int y = 0; y < height; y++) {
+        writeWord(&line[first_word], data, head_mask);
+        if (last_word > first_word) {
+            // full words in the middle
+            for (int x = first_word + 1; x < last_word; x++) {
+                line[x] = data;
+            }
+            writeWord(&line[last_word], data, tail_mask);
+        }
+        line += WORDS_PER_ROW;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                       Sprites / Bitmaps                                      |
+// ------------------------------------------------------------------------------------------------
+// sprite byte index of a row, 0 outside of the row
+static inline uint32_t spriteByte(const uint8_t *line, int stride, int index) {
+    return (index >= 0 && index < stride) ? line[index] : 0;
+}
+
+// 8 sprite pixels of a row starting at pixel x (may be negative or odd), same layout as the frame buffer
+static inline uint32_t spriteWord(const uint8_t *line, int stride, int x) {
+    int first = x >> 1;
+    uint32_t data = 0;
+    for (int i = 3; i >= 0; i--) {
+        data = (data << 8) | spriteByte(line, stride, first + i);
+    }
+    if (x & 1) {
+        data = (data >> 4) | (spriteByte(line, stride, first + 4) << 28);
+    }
+    return data;
+}
+
+void drawSprite(int row, int column, const uint8_t *sprite, int width, int height, int transparent) {
+    int stride = (width + 1) >> 1;
+
+    // clipped area (rows in sprite coordinates, columns in screen coordinates)
+    int y_start = (row    < 0) ? -row    : 0;
+    int y_end = (row + height > VGA_SCREEN_HEIGHT) ? VGA_SCREEN_HEIGHT - row : height;
+    int first_column = (column < 0) ? 0 : column;
+    int last_column  = ((column + width > VGA_SCREEN_WIDTH) ? VGA_SCREEN_WIDTH : column + width) - 1;
+    if (first_column > last_column) {
+        return;
+    }
+
+    int first_word = first_column >> 3;
+    int last_word  = last_column >> 3;
+    uint32_t head_mask = pixelMask(first_column & 0b111, (first_word == last_word) ? (last_column & 0b111) : 7);
+    uint32_t tail_mask = pixelMask(0, last_column & 0b111);
+    uint32_t key = nibbleBroadcast(transparent);
+
+    // one frame buffer word (8 pixels) at a time, transparent pixels are removed from the write mask
+    for (int y = y_start; y < y_end; y++) {
+        const uint8_t *line = sprite + y * stride;
+        volatile uint32_t *screen = VGA_START_WORD_ADDRESS + (row + y) * WORDS_PER_ROW;
+        for (int word = first_word; word <= last_word; word++) {
+            uint32_t data = spriteWord(line, stride, (word << 3) - column);
+            uint32_t mask = (word == first_word) ? head_mask : (word == last_word) ? tail_mask : 0xFFFFFFFF;
+            if (transparent != GRAPHICS_NO_COLOR) {
+                mask &= ~nibbleEqualMask(data, key);
+            }
+            writeWord(&screen[word], data, mask);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Text                                             |
+// ------------------------------------------------------------------------------------------------
+
+// 3x5 glyphs for ASCII 32-95, 3 bits per row (MSB = left pixel), first row in bits 14:12
+static const uint16_t font[64] = {
+    0x0000, 0x2482, 0x5a00, 0x5f7d, 0x3c9e, 0x52a5, 0x2aab, 0x2400, // ' ' '!' '"' '#' '$' '%' '&' '''
+    0x1491, 0x4494, 0x0aa8, 0x05d0, 0x0014, 0x01c0, 0x0002, 0x12a4, // '(' ')' '*' '+' ',' '-' '.' '/'
+    0x7b6f, 0x2c97, 0x73e7, 0x73cf, 0x5bc9, 0x79cf, 0x79ef, 0x7249, // '0' '1' '2' '3' '4' '5' '6' '7'
+    0x7bef, 0x7bcf, 0x0410, 0x0414, 0x1511, 0x0e38, 0x4454, 0x7282, // '8' '9' ':' ';' '<' '=' '>' '?'
+    0x7be7, 0x2bed, 0x6bae, 0x3923, 0x6b6e, 0x79a7, 0x79a4, 0x396b, // '@' 'A' 'B' 'C' 'D' 'E' 'F' 'G'
+    0x5bed, 0x7497, 0x126a, 0x5bad, 0x4927, 0x5fed, 0x6b6d, 0x2b6a, // 'H' 'I' 'J' 'K' 'L' 'M' 'N' 'O'
+    0x6ba4, 0x2b73, 0x6bad, 0x388e, 0x7492, 0x5b6f, 0x5b6a, 0x5bfd, // 'P' 'Q' 'R' 'S' 'T' 'U' 'V' 'W'
+    0x5aad, 0x5a92, 0x72a7, 0x3493, 0x4889, 0x6496, 0x2a00, 0x0007, // 'X' 'Y' 'Z' '[' '\' ']' '^' '_'
+};
+
+static inline uint32_t glyph(char c) {
+    if (c >= 'a' && c <= 'z') { c -= 'a' - 'A'; }
+    if (c < ' ' || c > '_')   { c = '?'; }
+    return font[c - ' '];
+}
+
+// draw a single line of text (no '\n'), one batch per pixel row
+static void drawTextLine(int row, int column, const char *text, int length, uint32_t color, int background) {
+    for (int y = 0; y < FONT_CHAR_HEIGHT; y++) {
+        if (row + y < 0 || row + y >= VGA_SCREEN_HEIGHT) {
+            continue;
+        }
+        pixel_batch_t batch;
+        batchStart(&batch);
+        for (int i = 0; i < length; i++) {
+            // glyph row (the last row of the cell is spacing)
+            uint32_t bits = (y < FONT_GLYPH_HEIGHT) ? (glyph(text[i]) >> ((FONT_GLYPH_HEIGHT - 1 - y) * FONT_GLYPH_WIDTH)) & 0b111 : 0;
+            for (int x = 0; x < FONT_CHAR_WIDTH; x++) {
+                int px_column = column + i * FONT_CHAR_WIDTH + x;
+                if (px_column < 0 || px_column >= VGA_SCREEN_WIDTH) {
+                    continue;
+                }
+                // the last column of the cell is spacing
+                int set = (x < FONT_GLYPH_WIDTH) && ((bits >> (FONT_GLYPH_WIDTH - 1 - x)) & 1);
+                if (set) {
+                    batchPixel(&batch, row + y, px_column, color);
+                }
+                else if (background != GRAPHICS_NO_COLOR) {
+                    batchPixel(&batch, row + y, px_column, background & 0xF);
+                }
+            }
+        }
+        batchFlush(&batch);
+    }
+}
+
+void drawText(int row, int column, const char *text, vga_color_t color, int background) {
+    while (*text) {
+        int length = 0;
+        while (text[length] && text[length] != '\n') {
+            length++;
+        }
+        drawTextLine(row, column, text, length, color, background);
+        text += length;
+        if (*text == '\n') {
+            text++;
+        }
+        row += FONT_CHAR_HEIGHT;
+    }
+}
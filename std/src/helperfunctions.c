@@ -8,60 +8,50 @@
 
 
 #include "helperfunctions.h"
+#include "packed.h"
 
 // ------------------------------------------------------------------------------------------------
 // |                              Convert digit/number to 7 segment                               |
 // ------------------------------------------------------------------------------------------------
+// segment encoding of the digits 0-9, 10-15 are blank
+static const uint8_t digit_segments[16] = {
+    0b00111111, 0b00000110, 0b01011011, 0b01001111,
+    0b01100110, 0b01101101, 0b01111101, 0b00000111,
+    0b01111111, 0b01101111, 0b00000000, 0b00000000,
+    0b00000000, 0b00000000, 0b00000000, 0b00000000
+};
+
 uint32_t digit2segment(uint32_t digit) {
-    uint32_t retval = 0;
-    switch (digit) {
-        case  0: retval = 0b00111111; break;
-        case  1: retval = 0b00000110; break;
-        case  2: retval = 0b01011011; break;
-        case  3: retval = 0b01001111; break;
-        case  4: retval = 0b01100110; break;
-        case  5: retval = 0b01101101; break;
-        case  6: retval = 0b01111101; break;
-        case  7: retval = 0b00000111; break;
-        case  8: retval = 0b01111111; break;
-        case  9: retval = 0b01101111; break;
-        case 10: retval = 0b00000000; break;
-        case 11: retval = 0b00000000; break;
-        case 12: retval = 0b00000000; break;
-        case 13: retval = 0b00000000; break;
-        case 14: retval = 0b00000000; break;
-        case 15: retval = 0b00000000; break;
-        default: retval = 0b00000000; break;
+    return digit < 16 ? digit_segments[digit] : 0;
+}
+
+/* divide number by a power of ten using shift and subtract (no M extension)
+    @quotient_bits: number of quotient bits to test, the quotient must fit
+    @return: quotient, number is replaced by the remainder
+*/
+static inline uint32_t divideShiftSubtract(uint32_t *number, uint32_t divisor, int quotient_bits) {
+    uint32_t quotient = 0;
+    for (int shift = quotient_bits - 1; shift >= 0; shift--) {
+        if ((*number >> shift) >= divisor) {
+            *number -= divisor << shift;
+            quotient |= 1 << shift;
+        }
     }
-    return retval;
+    return quotient;
 }
 
 uint32_t number2segment(uint32_t number) {
-    uint32_t segment = 0;
-    // clip value to 0...9999
-    while (number > 9999) { number = number - 10000; }
-    // Calculate digits
-    uint32_t digit;
-    // Calculate 1000er digit
-    digit = 0;
-    while (number >= 1000) { number -= 1000; digit++; }
-    segment = segment << 8;
-    segment = segment | (digit2segment(digit) & 0x00FF);
-    // Calculate 100er digit
-    digit = 0;
-    while (number >= 100) { number -= 100; digit++; }
-    segment = segment << 8;
-    segment = segment | (digit2segment(digit) & 0x00FF);
-    // Calculate 10er digit
-    digit = 0;
-    while (number >= 10) { number -= 10; digit++; }
-    segment = segment << 8;
-    segment = segment | (digit2segment(digit) & 0x00FF);
-    // Calculate 1er digit
-    segment = segment << 8;
-    segment = segment | (digit2segment(number) & 0x00FF);
-
-    return segment;
+    // clip value to 0...9999 (remainder of number / 10000, quotient < 2^19)
+    divideShiftSubtract(&number, 10000, 19);
+    // Calculate digits (each quotient < 10 => 4 bits)
+    uint32_t thousands = divideShiftSubtract(&number, 1000, 4);
+    uint32_t hundreds  = divideShiftSubtract(&number,  100, 4);
+    uint32_t tens      = divideShiftSubtract(&number,   10, 4);
+
+    return (digit_segments[thousands] << 24) |
+           (digit_segments[hundreds]  << 16) |
+           (digit_segments[tens]      <<  8) |
+           (digit_segments[number]    <<  0);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -122,10 +112,7 @@ uint8_t setPixelHalfword(int px_idx, vga_color_t color) {
     // get array index (4 pixels per 16 bit)
     int halfword_array_idx = px_idx >> 2;
     // modify 4 pixels
-    VGA_START_HALFWORD_ADDRESS[halfword_array_idx] = ( (color << 12) |
-                                                       (color <<  8) |
-                                                       (color <<  4) |
-                                                       (color <<  0) );
+    VGA_START_HALFWORD_ADDRESS[halfword_array_idx] = nibbleBroadcast(color);
     return 1;
 }
 
@@ -141,26 +128,63 @@ uint8_t setPixelWord(int px_idx, vga_color_t color) {
     // get array index (8 pixels per 32 bit)
     int word_array_idx = px_idx >> 3;
     // modify 8 pixels
-    VGA_START_WORD_ADDRESS[word_array_idx] = ( (color << 28) |
-                                               (color << 24) |
-                                               (color << 20) |
-                                               (color << 16) |
-                                               (color << 12) |
-                                               (color <<  8) |
-                                               (color <<  4) |
-                                               (color <<  0) );
+    VGA_START_WORD_ADDRESS[word_array_idx] = nibbleBroadcast(color);
     return 1;
 }
 
+// ------------------------------------------------------------------------------------------------
+// |                                            Timer                                             |
+// ------------------------------------------------------------------------------------------------
+uint64_t readMachineTime() {
+    // reading the lower half latches the upper half (per hart)
+    uint32_t low  = *TIMER_MTIME_ADDRESS;
+    uint32_t high = *TIMER_MTIMEH_LATCHED_ADDRESS;
+    return ((uint64_t)high << 32) | low;
+}
+
+uint64_t readMachineTimeHiLoHi() {
+    // retry if the lower half overflowed between the reads of the upper half
+    uint32_t high;
+    uint32_t low;
+    do {
+        high = *TIMER_MTIMEH_ADDRESS;
+        low  = *TIMER_MTIME_ADDRESS;
+    } while (high != *TIMER_MTIMEH_ADDRESS);
+    return ((uint64_t)high << 32) | low;
+}
+
+void setupPeriodicTimer(uint32_t period_cycles) {
+    uint64_t first = readMachineTime() + period_cycles;
+    // stop periodic mode while the compare value is not consistent
+    *TIMER_MTIMECTRL_ADDRESS   = 0;
+    *TIMER_MTIMECMPH_ADDRESS   = 0xFFFFFFFF;
+    *TIMER_MTIMECMP_ADDRESS    = (uint32_t)first;
+    *TIMER_MTIMECMPH_ADDRESS   = (uint32_t)(first >> 32);
+    *TIMER_MTIMEPERIOD_ADDRESS = period_cycles;
+    *TIMER_PENDING_ADDRESS     = (1<<TIMER_PENDING_IDX_MTIME);
+    *TIMER_MTIMECTRL_ADDRESS   = (1<<TIMER_MTIMECTRL_IDX_PERIODIC);
+}
+
+void setupTimerChannel(uint8_t channel, uint32_t period_cycles, uint32_t compare, uint32_t ctrl) {
+    *TIMER_CH_CTRL_ADDRESS(channel)    = 0;
+    *TIMER_CH_PERIOD_ADDRESS(channel)  = period_cycles;
+    *TIMER_CH_COMPARE_ADDRESS(channel) = compare;
+    *TIMER_CH_COUNTER_ADDRESS(channel) = 0;
+    *TIMER_PENDING_ADDRESS = (1<<TIMER_PENDING_IDX_RELOAD(channel)) | (1<<TIMER_PENDING_IDX_COMPARE(channel));
+    *TIMER_CH_CTRL_ADDRESS(channel)    = ctrl | (1<<TIMER_CH_CTRL_IDX_ENABLE);
+}
+
+void clearTimerPending(uint32_t mask) {
+    *TIMER_PENDING_ADDRESS = mask;
+}
+
 // ------------------------------------------------------------------------------------------------
 // |                             enable/disable individual interrupts                             |
 // ------------------------------------------------------------------------------------------------
 void enableDisable_machineInterrupts(uint8_t enable_disable) {
-    uint32_t mstatus = 0;
-    asm volatile("csrr %0, mstatus": "=r"(mstatus));
-    if (enable_disable) { mstatus |=  (1<<3); } // MSTATUS_MIE
-    else                { mstatus &= ~(1<<3); } // MSTATUS_MIE
-    asm volatile("csrw mstatus, %0": : "r"(mstatus));
+    // single set/clear instead of read-modify-write (see lockfree.h for critical sections)
+    if (enable_disable) { asm volatile("csrsi mstatus, 8" : : : "memory"); } // MSTATUS_MIE
+    else                { asm volatile("csrci mstatus, 8" : : : "memory"); } // MSTATUS_MIE
 }
 void enableDisable_timerInterrupts(uint8_t enable_disable) {
     uint32_t mie = 0;
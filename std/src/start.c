@@ -7,6 +7,8 @@
 
 
 
+#include <string.h>
+
 #include "peripherals.h"
 
 // ------------------------------------------------------------------------------------------------
@@ -15,6 +17,13 @@
 // ------------------------------------------------------------------------------------------------
 int main();
 
+// ------------------------------------------------------------------------------------------------
+// | Forward declaration of the entry point of the harts 1 ... NUM_HARTS - 1 (see multicore.h).   |
+// | Optional: the other harts are only started if the user program defines it.                   |
+// ------------------------------------------------------------------------------------------------
+__attribute__((weak))
+void hart_main(uint32_t hart);
+
 // ------------------------------------------------------------------------------------------------
 // | The actual reset vector and the first code that is executed.                                 |
 // | This function must be raw assembly.                                                          |
@@ -29,8 +38,9 @@ void __reset() {
     asm("la gp, __global_pointer$");
     asm(".option pop");
 
-    // Initialize stack pointer
-    asm("la sp, __ram_end");
+    // Initialize stack pointer (end of the tightly coupled memory, every hart has its own TCM,
+    // end of RAM without the TCM)
+    asm("la sp, __stack_top");
 
     // Jump to c code
     asm("j __start");
@@ -39,8 +49,70 @@ void __reset() {
 // ------------------------------------------------------------------------------------------------
 // |                                             Start                                            |
 // ------------------------------------------------------------------------------------------------
+extern char __data_load;
+extern char __data_start;
+extern char __data_end;
+extern char __tcm_load;
+extern char __tcm_start;
+extern char __tcm_end;
+extern char __tcm_bss_start;
+extern char __tcm_bss_end;
+extern char __bss_start;
+extern char __bss_end;
+extern char __local_load;
+extern char __local_start;
+extern char __local_end;
+
+// The shared RAM has already been initialized by hart 0, only the TCM and the local memory of this
+// hart are initialized before its entry point is called.
+static void __start_hart(uint32_t hart) {
+    memcpy(&__tcm_start, &__tcm_load, &__tcm_end - &__tcm_start);
+    memset(&__tcm_bss_start, 0, &__tcm_bss_end - &__tcm_bss_start);
+    memcpy(&__local_start, &__local_load, &__local_end - &__local_start);
+
+    // The image in RAM may differ from the one of hart 0 (e.g. the bootloader for XIP programs)
+    if (hart_main) {
+        hart_main(hart);
+    }
+
+    // Stop this hart (held in reset until it is started again)
+    *MAILBOX_HALT_ADDRESS = 1 << hart;
+
+    // Loop forever
+    while (1);
+}
+
 void __start() {
-    // TODO: Initialize everything, e.g. clear data/bss
+    // All harts start here, mhartid is 0 on every hart (the mailbox knows the requesting hart)
+    uint32_t hart = *MAILBOX_HARTID_ADDRESS;
+    if (hart != 0) {
+        __start_hart(hart);
+    }
+
+    // All section boundaries are word aligned (see hades-v.ld.in), so memcpy/memset only
+    // use their unrolled word loops.
+
+    // Copy initial values of .data/.sdata from the flash (XIP only, otherwise they are loaded
+    // at their final address in RAM)
+    if (&__data_load != &__data_start) {
+        memcpy(&__data_start, &__data_load, &__data_end - &__data_start);
+    }
+
+    // Copy initial values of .tcm from RAM (XIP: flash) into the tightly coupled memory (without
+    // the TCM, .tcm is loaded at its final address in RAM, see TCM_ENABLE)
+    if (&__tcm_load != &__tcm_start) {
+        memcpy(&__tcm_start, &__tcm_load, &__tcm_end - &__tcm_start);
+    }
+
+    // Clear .sbss/.bss and .tcm_bss
+    memset(&__bss_start, 0, &__bss_end - &__bss_start);
+    memset(&__tcm_bss_start, 0, &__tcm_bss_end - &__tcm_bss_start);
+
+    // Start the other harts (held in reset until now, see wishbone_mailbox.sv)
+    if (hart_main) {
+        *MAILBOX_RUN_ADDRESS = ~1u;
+    }
+
     main();
 
     // Signal halt via test register
@@ -0,0 +1,164 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: string.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | memcpy/memmove/memset and basic string functions for programs linked with -nostdlib.         |
+// | The compiler also emits calls to these functions (struct copies, array initializers).        |
+// |                                                                                              |
+// | Aligned buffers are processed one word per load/store, the main loops are unrolled 4 times   |
+// | (16 bytes per iteration) to reduce the branch overhead. Unaligned heads/tails fall back      |
+// | to byte accesses. If source and destination have different alignment, bytes are used.        |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Prevent gcc from replacing the loops below with calls to memcpy/memset (endless recursion)
+#define NO_BUILTIN_LOOPS __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+NO_BUILTIN_LOOPS
+void *memcpy(void *dest, const void *src, size_t n) {
+    uint8_t *d = dest;
+    const uint8_t *s = src;
+
+    if ((((uintptr_t) d ^ (uintptr_t) s) & 0b11) == 0) {
+        // byte head up to the word boundary
+        while (((uintptr_t) d & 0b11) && n) { *d++ = *s++; n--; }
+
+        uint32_t *dw = (uint32_t *) d;
+        const uint32_t *sw = (const uint32_t *) s;
+        // 4 words per iteration
+        while (n >= 16) {
+            uint32_t w0 = sw[0];
+            uint32_t w1 = sw[1];
+            uint32_t w2 = sw[2];
+            uint32_t w3 = sw[3];
+            dw[0] = w0;
+            dw[1] = w1;
+            dw[2] = w2;
+            dw[3] = w3;
+            dw += 4;
+            sw += 4;
+            n  -= 16;
+        }
+        // remaining words
+        while (n >= 4) { *dw++ = *sw++; n -= 4; }
+
+        d = (uint8_t *) dw;
+        s = (const uint8_t *) sw;
+    }
+
+    // byte tail (or everything for mismatched alignment)
+    while (n) { *d++ = *s++; n--; }
+
+    return dest;
+}
+
+NO_BUILTIN_LOOPS
+void *memmove(void *dest, const void *src, size_t n) {
+    uint8_t *d = dest;
+    const uint8_t *s = src;
+
+    // forward copy is safe if dest is before src or the buffers don't overlap
+    if (d <= s || d >= s + n) {
+        return memcpy(dest, src, n);
+    }
+
+    // backward copy
+    d += n;
+    s += n;
+    if ((((uintptr_t) d ^ (uintptr_t) s) & 0b11) == 0) {
+        // byte tail down to the word boundary
+        while (((uintptr_t) d & 0b11) && n) { *--d = *--s; n--; }
+
+        uint32_t *dw = (uint32_t *) d;
+        const uint32_t *sw = (const uint32_t *) s;
+        // 4 words per iteration
+        while (n >= 16) {
+            uint32_t w3 = sw[-1];
+            uint32_t w2 = sw[-2];
+            uint32_t w1 = sw[-3];
+            uint32_t w0 = sw[-4];
+            dw[-1] = w3;
+            dw[-2] = w2;
+            dw[-3] = w1;
+            dw[-4] = w0;
+            dw -= 4;
+            sw -= 4;
+            n  -= 16;
+        }
+        // remaining words
+        while (n >= 4) { *--dw = *--sw; n -= 4; }
+
+        d = (uint8_t *) dw;
+        s = (const uint8_t *) sw;
+    }
+
+    // byte head (or everything for mismatched alignment)
+    while (n) { *--d = *--s; n--; }
+
+    return dest;
+}
+
+NO_BUILTIN_LOOPS
+void *memset(void *dest, int c, size_t n) {
+    uint8_t *d = dest;
+
+    // byte head up to the word boundary
+    while (((uintptr_t) d & 0b11) && n) { *d++ = (uint8_t) c; n--; }
+
+    // replicate byte into all lanes (without multiplication, RV32I)
+    uint32_t w = (uint8_t) c;
+    w |= w << 8;
+    w |= w << 16;
+
+    uint32_t *dw = (uint32_t *) d;
+    // 4 words per iteration
+    while (n >= 16) {
+        dw[0] = w;
+        dw[1] = w;
+        dw[2] = w;
+        dw[3] = w;
+        dw += 4;
+        n  -= 16;
+    }
+    // remaining words
+    while (n >= 4) { *dw++ = w; n -= 4; }
+
+    // byte tail
+    d = (uint8_t *) dw;
+    while (n) { *d++ = (uint8_t) c; n--; }
+
+    return dest;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Strings                                           |
+// ------------------------------------------------------------------------------------------------
+size_t strlen(const char *str) {
+    const char *end = str;
+    while (*end) { end++; }
+    return end - str;
+}
+
+char *strcpy(char *dest, const char *src) {
+    char *d = dest;
+    while ((*d++ = *src++));
+    return dest;
+}
+
+int strcmp(const char *str_1, const char *str_2) {
+    while (*str_1 && *str_1 == *str_2) {
+        str_1++;
+        str_2++;
+    }
+    return (uint8_t) *str_1 - (uint8_t) *str_2;
+}
@@ -0,0 +1,181 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: uart.c
+ */
+
+
+
+#include <stdarg.h>
+
+#include "uart.h"
+
+// ------------------------------------------------------------------------------------------------
+// |                                 Convert number to string                                     |
+// ------------------------------------------------------------------------------------------------
+
+// powers of ten that fit in 32 bit (highest first)
+static const uint32_t powers_of_ten[10] = {
+    1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+};
+
+static const char hex_digits[] = "0123456789abcdef";
+
+int uint2str(uint32_t value, char *buffer, uint32_t base) {
+    int length = 0;
+
+    if (base == 16) {
+        // one digit per nibble, skip leading zeros
+        int shift = 28;
+        while (shift > 0 && (value >> shift) == 0) { shift -= 4; }
+        for (; shift >= 0; shift -= 4) {
+            buffer[length++] = hex_digits[(value >> shift) & 0xF];
+        }
+    }
+    else {
+        // every digit is < 10, i.e. 4 quotient bits (shift and subtract, no M extension)
+        int leading = 1;
+        for (int i = 0; i < 10; i++) {
+            uint32_t power = powers_of_ten[i];
+            uint32_t digit = 0;
+            for (int shift = 3; shift >= 0; shift--) {
+                if ((value >> shift) >= power) {
+                    value -= power << shift;
+                    digit |= 1 << shift;
+                }
+            }
+            if (digit != 0 || !leading || i == 9) {
+                buffer[length++] = '0' + digit;
+                leading = 0;
+            }
+        }
+    }
+
+    buffer[length] = '\0';
+    return length;
+}
+
+int int2str(int32_t value, char *buffer) {
+    if (value < 0) {
+        buffer[0] = '-';
+        // note: works for INT32_MIN as well (unsigned negation)
+        return 1 + uint2str(-(uint32_t) value, buffer + 1, 10);
+    }
+    return uint2str(value, buffer, 10);
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                          UART output                                         |
+// ------------------------------------------------------------------------------------------------
+void uartPutChar(char c) {
+    while (!(*UART_TX_STATUS_ADDRESS & (1 << UART_TX_STATUS_IDX_EMPTY)));
+    *UART_BUFFER_ADDRESS = c;
+}
+
+void uartPutString(const char *str) {
+    while (*str) {
+        uartPutChar(*str);
+        str++;
+    }
+}
+
+static int uartPutPadded(const char *str, int length, int width, char pad, int left_align) {
+    int count = 0;
+    // a zero padded negative number keeps its sign in front
+    if (pad == '0' && str[0] == '-' && length < width) {
+        uartPutChar('-');
+        str++;
+        length--;
+        width--;
+        count++;
+    }
+    if (!left_align) {
+        for (; width > length; width--) { uartPutChar(pad); count++; }
+    }
+    for (int i = 0; i < length; i++) { uartPutChar(str[i]); count++; }
+    for (; width > length; width--) { uartPutChar(' '); count++; }
+    return count;
+}
+
+int uartPrintf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    char buffer[NUMBER_STRING_SIZE];
+    int count = 0;
+
+    for (; *format; format++) {
+        if (*format != '%') {
+            uartPutChar(*format);
+            count++;
+            continue;
+        }
+        format++;
+
+        // flags
+        char pad = ' ';
+        int left_align = 0;
+        for (;; format++) {
+            if      (*format == '0') { pad = '0'; }
+            else if (*format == '-') { left_align = 1; }
+            else                     { break; }
+        }
+        if (left_align) { pad = ' '; }
+
+        // field width (multiply by 10 using shifts)
+        int width = 0;
+        while (*format >= '0' && *format <= '9') {
+            width = (width << 3) + (width << 1) + (*format - '0');
+            format++;
+        }
+
+        const char *str = buffer;
+        int length;
+        switch (*format) {
+            case 'c':
+                buffer[0] = (char) va_arg(args, int);
+                length = 1;
+                break;
+            case 's':
+                str = va_arg(args, const char *);
+                for (length = 0; str[length]; length++);
+                break;
+            case 'd':
+            case 'i':
+                length = int2str(va_arg(args, int32_t), buffer);
+                break;
+            case 'u':
+                length = uint2str(va_arg(args, uint32_t), buffer, 10);
+                break;
+            case 'p':
+            case 'x':
+            case 'X':
+                length = uint2str(va_arg(args, uint32_t), buffer, 16);
+                if (*format == 'X') {
+                    for (int i = 0; i < length; i++) {
+                        if (buffer[i] >= 'a') { buffer[i] -= 'a' - 'A'; }
+                    }
+                }
+                break;
+            case '%':
+                buffer[0] = '%';
+                length = 1;
+                break;
+            case '\0':
+                // incomplete conversion at the end of the format string
+                va_end(args);
+                return count;
+            default:
+                // unknown conversion, print it unchanged
+                buffer[0] = '%';
+                buffer[1] = *format;
+                length = 2;
+                break;
+        }
+        count += uartPutPadded(str, length, width, pad, left_align);
+    }
+
+    va_end(args);
+    return count;
+}
@@ -0,0 +1,113 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: fmax_sweep.tcl
+#
+# Implements the design for increasing system clock frequencies and reports the
+# highest frequency that still meets timing (setup and hold).
+#
+# Environment variables (all optional):
+#   FMAX_CANDIDATES  list of "MMCM_MUL MMCM_DIV_0" pairs, sorted by frequency
+#   FMAX_GENERICS    additional top level parameters (default: REGISTERED_BUS=1)
+#   FMAX_MAX_FAILS   stop after this many consecutive failing frequencies (default: 2)
+#   SYNTH_GENERICS   top level parameters shared with synth.tcl (e.g. MEMORY_SIZE_KB)
+
+# Get root directory
+set ROOT [file normalize [file dirname [info script]]/..]
+
+# Read sources, constraints and memory file (once, every run re-elaborates them)
+source $ROOT/synth/read_sources.tcl
+
+# VCO = 100 MHz * MMCM_MUL must stay within 600 - 1200 MHz (see clk_params.sv)
+set CANDIDATES {
+    10.000 20.000
+    10.000 16.000
+    10.000 14.000
+    10.000 12.500
+    10.000 12.000
+    10.000 11.500
+    10.000 11.000
+    10.000 10.500
+    10.000 10.000
+    10.000  9.500
+    10.000  9.000
+}
+if {[info exists ::env(FMAX_CANDIDATES)]} {
+    set CANDIDATES $::env(FMAX_CANDIDATES)
+}
+
+set EXTRA_GENERICS {REGISTERED_BUS=1}
+if {[info exists ::env(FMAX_GENERICS)]} {
+    set EXTRA_GENERICS $::env(FMAX_GENERICS)
+}
+
+set MAX_FAILS 2
+if {[info exists ::env(FMAX_MAX_FAILS)]} {
+    set MAX_FAILS $::env(FMAX_MAX_FAILS)
+}
+
+file mkdir reports/fmax
+set csv [open reports/fmax/sweep.csv w]
+puts $csv "mmcm_mul,mmcm_div_0,frequency_mhz,wns_ns,whs_ns,met"
+
+set best_frequency 0
+set best_config {}
+set fails 0
+
+foreach {mul div} $CANDIDATES {
+    set frequency [format "%.3f" [expr {100.0 * $mul / $div}]]
+    puts "INFO: fmax sweep: MMCM_MUL=$mul MMCM_DIV_0=$div => $frequency MHz"
+
+    set generics [list -generic MMCM_MUL=$mul -generic MMCM_DIV_0=$div]
+    foreach generic $EXTRA_GENERICS {
+        lappend generics -generic $generic
+    }
+    if {[info exists ::env(SYNTH_GENERICS)]} {
+        foreach generic $::env(SYNTH_GENERICS) {
+            lappend generics -generic $generic
+        }
+    }
+
+    # Synthesize, place and route
+    synth_design -top top -part xc7a35tcpg236-1 {*}$generics
+    opt_design
+    place_design
+    phys_opt_design
+    route_design
+    phys_opt_design
+
+    # Worst setup and hold slack over all clocks
+    set wns [get_property SLACK [get_timing_paths -delay_type max -max_paths 1 -nworst 1]]
+    set whs [get_property SLACK [get_timing_paths -delay_type min -max_paths 1 -nworst 1]]
+    set met [expr {$wns >= 0 && $whs >= 0}]
+
+    report_timing_summary -file reports/fmax/timing_${frequency}mhz.rpt
+    puts $csv "$mul,$div,$frequency,$wns,$whs,$met"
+    flush $csv
+
+    close_design
+
+    if {$met} {
+        set fails 0
+        if {$frequency > $best_frequency} {
+            set best_frequency $frequency
+            set best_config "MMCM_MUL=$mul MMCM_DIV_0=$div"
+        }
+    } else {
+        incr fails
+        if {$fails >= $MAX_FAILS} {
+            break
+        }
+    }
+}
+
+close $csv
+
+if {$best_frequency > 0} {
+    puts "INFO: fmax sweep: highest frequency meeting timing: $best_frequency MHz ($best_config $EXTRA_GENERICS)"
+    puts "INFO: fmax sweep: build it with: make synthesis SYNTH_GENERICS=\"$best_config $EXTRA_GENERICS\""
+} else {
+    puts "ERROR: fmax sweep: no candidate met timing"
+    exit 1
+}
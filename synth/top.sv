@@ -7,7 +7,22 @@
 
 
 
-module top(
+module top #(
+    // System clock configuration (see clk_params.sv), can be overridden by synth_design -generic
+    parameter real MMCM_MUL       = clk_params::MMCM_MUL,
+    parameter real MMCM_DIV_0     = clk_params::MMCM_DIV_0,
+    // High frequency configuration (see mcu.sv)
+    parameter bit  REGISTERED_BUS = 0,
+    // Program memory configuration (set by the Makefile, see MEMORY_SIZE_KB)
+    parameter int  MEMORY_SIZE_KB = 32,
+    parameter int  MEMORY_BANKS   = 1,
+    // Tightly coupled data memory (set by the Makefile, see TCM_ENABLE)
+    parameter bit  TCM_ENABLE     = 0,
+    // Bus monitor counters (see mcu.sv), e.g. SYNTH_GENERICS="BUS_MONITOR=1"
+    parameter bit  BUS_MONITOR    = 0,
+    // Number of harts (set by the Makefile, see NUM_CORES)
+    parameter int  NUM_CORES      = 1
+) (
     // 100 MHz input clock
     input logic clk_100mhz,
 
@@ -33,7 +48,14 @@ module top(
 
     // UART
     input  logic uart_rx_async,
-    output logic uart_tx
+    output logic uart_tx,
+
+    // Timer output compare / PWM (Pmod JA 1-4)
+    output logic [3:0] timer_pwm,
+
+    // QSPI configuration flash (the clock is driven through STARTUPE2)
+    output logic       flash_cs_n,
+    inout  wire  [3:0] flash_dq
 );
 
     // --------------------------------------------------------------------------------------------
@@ -41,6 +63,8 @@ module top(
     // --------------------------------------------------------------------------------------------
     import clk_params::*;
 
+    localparam real CLK_FREQUENCY_MHZ = (INPUT_CLK_FREQUENCY_MHZ / MMCM_DIV * MMCM_MUL) / MMCM_DIV_0;
+
     logic clk;
     logic clk_fb;
     logic clk_mem;
@@ -54,7 +78,7 @@ module top(
         .STARTUP_WAIT("TRUE")                     // Wait for lock before enabling device outputs and registers
     ) mmcm (
         .CLKIN1(clk_100mhz), // Input clock
-        .CLKOUT0(clk),       // Output clock: (100 MHz / 1 * 10) / 20 = 50 MHz
+        .CLKOUT0(clk),       // Output clock: (100 MHz / 1 * 10) / 20 = 50 MHz (default)
         .CLKOUT0B(clk_mem),  // Inverted output clock
 
         .CLKFBOUT(clk_fb),   // Feedback out
@@ -144,9 +168,20 @@ module top(
     // |                                    MCU Instantiation                                     |
     // --------------------------------------------------------------------------------------------
 
+    logic       flash_sck;
+    logic [3:0] flash_dq_out;
+    logic [3:0] flash_dq_oe;
+    logic [3:0] flash_dq_in;
+
     mcu #(
-        .CLK_FREQUENCY_MHZ(SYS_CLK_FREQUENCY_MHZ),
-        .UART_BAUD_RATE(115200)
+        .CLK_FREQUENCY_MHZ(CLK_FREQUENCY_MHZ),
+        .UART_BAUD_RATE(115200),
+        .REGISTERED_BUS(REGISTERED_BUS),
+        .MEMORY_SIZE_KB(MEMORY_SIZE_KB),
+        .MEMORY_BANKS(MEMORY_BANKS),
+        .TCM_ENABLE(TCM_ENABLE),
+        .BUS_MONITOR(BUS_MONITOR),
+        .NUM_CORES(NUM_CORES)
     ) mcu (
         .clk(clk),
         .clk_mem(~clk),
@@ -162,6 +197,46 @@ module top(
         .vga_hsync(vga_hsync),
         .vga_vsync(vga_vsync),
         .uart_rx_async(uart_rx_async),
-        .uart_tx(uart_tx)
+        .uart_tx(uart_tx),
+        .timer_pwm(timer_pwm),
+        .flash_cs_n(flash_cs_n),
+        .flash_sck(flash_sck),
+        .flash_dq_out(flash_dq_out),
+        .flash_dq_oe(flash_dq_oe),
+        .flash_dq_in(flash_dq_in)
+    );
+
+    // --------------------------------------------------------------------------------------------
+    // |                                       QSPI Flash                                         |
+    // --------------------------------------------------------------------------------------------
+
+    for (genvar i = 0; i < 4; i++) begin: flash_dq_buffer
+        IOBUF flash_dq_iobuf (
+            .I(flash_dq_out[i]),
+            .T(!flash_dq_oe[i]), // 1 = high impedance
+            .O(flash_dq_in[i]),
+            .IO(flash_dq[i])
+        );
+    end
+
+    // CCLK is a dedicated configuration pin, the user clock is routed through STARTUPE2.
+    // Note: the first 3 clock cycles after the configuration are ignored (mode bit reset only).
+    STARTUPE2 #(
+        .PROG_USR("FALSE"),
+        .SIM_CCLK_FREQ(0.0)
+    ) startup (
+        .USRCCLKO(flash_sck), // Flash clock
+        .USRCCLKTS(0),        // Drive CCLK
+        .USRDONEO(1),
+        .USRDONETS(1),
+        .GSR(0),
+        .GTS(0),
+        .KEYCLEARB(1),
+        .PACK(0),
+        .CLK(0),
+        .CFGCLK(),
+        .CFGMCLK(),
+        .EOS(),
+        .PREQ()
     );
 endmodule
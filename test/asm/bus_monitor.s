@@ -0,0 +1,155 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: bus_monitor.s
+#
+# ------------------------------------------------------------------------------------------------
+# |                                                                                              |
+# | Bus monitor test (register window, transaction counters and latency histogram).              |
+# | If everything runs correctly, the first register of the peripheral test module               |
+# | should always be zero, except during the first test, which checks the assert macro itself.   |
+# | Note: This condition is necessary, but not sufficient to prove coreectness.                  |
+# |                                                                                              |
+# | Register allocation:                                                                         |
+# |     x0  (zero): hardwired 0                                                                  |
+# |     x5  (t0):   reserved for macro use                                                       |
+# |     x6  (t1):   constant 1                                                                   |
+# |     x7  (t2):   test case number                                                             |
+# |     x18 (s2):   constant 0x86000<<2 (bus monitor address)                                    |
+# |     x28 (t3):   constant 0x120000<<2 (test peripheral address)                               |
+# |     x30 (t5):   temporary register                                                           |
+# |     x31 (t6):   temporary register                                                           |
+# |                                                                                              |
+# ------------------------------------------------------------------------------------------------
+
+.macro pass
+    sw zero, 0(t3)
+.endm
+
+.macro fail
+    sw t1, 0(t3)
+.endm
+
+.macro halt
+    addi t0, zero, 2
+    sw   t0, 0(t3)
+.endm
+
+.macro assert_equal r1:req, r2:req
+    sub  t0, \r1, \r2
+    sltu t0, zero, t0
+    sw   t0, 0(t3)
+.endm
+
+.macro assert_value reg:req, value: req
+    lui  t0,     %hi(\value)
+    addi t0, t0, %lo(\value)
+    assert_equal t0, \reg
+.endm
+
+.macro flush_pipeline
+    nop
+    nop
+    nop
+    nop
+    nop
+.endm
+
+# Bus monitor register byte offsets
+.equ BUSMON_CTRL,           (0 << 2)
+.equ BUSMON_INFO,           (1 << 2)
+.equ BUSMON_CYCLES,         (2 << 2)
+# Counters of the test peripheral (slave 8)
+.equ BUSMON_TEST_READS,     ((16 * 9 + 0) << 2)
+.equ BUSMON_TEST_WRITES,    ((16 * 9 + 1) << 2)
+.equ BUSMON_TEST_LATENCY,   ((16 * 9 + 3) << 2)
+.equ BUSMON_TEST_BIN_1,     ((16 * 9 + 4) << 2)
+.equ BUSMON_TEST_BIN_3_4,   ((16 * 9 + 6) << 2)
+
+.global __reset
+__reset:
+    beq  zero, zero, test_init
+    # jump to reset if this code snipped reached
+    flush_pipeline
+    beq  zero, zero, __reset
+
+# ------------------------------------------------------------------------------------------------
+# |                                          Test entry!                                         |
+# ------------------------------------------------------------------------------------------------
+test_init:
+    addi t1, zero, 1              # t1 = 1
+    addi t2, zero, 0              # t2 = test case number
+    lui  t3, %hi(0x120000<<2)     # t3 = peripheral test address
+    lui  s2, %hi(0x86000<<2)      # s2 = bus monitor address
+    flush_pipeline
+    addi t3, t3, %lo(0x120000<<2)
+    addi s2, s2, %lo(0x86000<<2)
+
+test_fail:
+    addi t2, zero, 1
+    assert_value zero, 1
+
+# -----------------------------------------------
+# Info register: 12 slaves, 8 histogram bins
+test_info:
+    addi t2, zero, 2
+    lw   t5, BUSMON_INFO(s2)
+    assert_value t5, ((8 << 8) | 12)
+
+# -----------------------------------------------
+# Cycle counter runs while enabled
+test_cycles:
+    addi t2, zero, 3
+    lw   t5, BUSMON_CYCLES(s2)
+    flush_pipeline
+    lw   t6, BUSMON_CYCLES(s2)
+    sltu t5, t5, t6
+    assert_value t5, 1
+
+# -----------------------------------------------
+# Counters of the test peripheral
+test_counters:
+    addi t2, zero, 4
+    # clear and enable
+    addi t5, zero, 0b11
+    sw   t5, BUSMON_CTRL(s2)
+    # 3 single cycle reads (counter register)
+    lw   t5, 8(t3)
+    lw   t5, 8(t3)
+    lw   t5, 8(t3)
+    # 2 reads acknowledged after 4 cycles (stall register, the nop restarts its delay)
+    lw   t5, 12(t3)
+    nop
+    lw   t5, 12(t3)
+    # stop counting before the asserts write to the test peripheral
+    sw   zero, BUSMON_CTRL(s2)
+    lw   t5, BUSMON_CTRL(s2)
+    assert_value t5, 0
+    lw   t5, BUSMON_TEST_READS(s2)
+    lw   t6, BUSMON_TEST_WRITES(s2)
+    assert_value t5, 5
+    assert_value t6, 0
+    lw   t5, BUSMON_TEST_BIN_1(s2)
+    lw   t6, BUSMON_TEST_BIN_3_4(s2)
+    assert_value t5, 3
+    assert_value t6, 2
+    lw   t5, BUSMON_TEST_LATENCY(s2)
+    assert_value t5, 11
+
+# -----------------------------------------------
+# Clear resets the counters
+test_clear:
+    addi t2, zero, 5
+    addi t5, zero, 0b10
+    sw   t5, BUSMON_CTRL(s2)
+    lw   t5, BUSMON_TEST_READS(s2)
+    assert_value t5, 0
+
+# ------------------------------------------------------------------------------------------------
+# |                                          Test done!                                          |
+# ------------------------------------------------------------------------------------------------
+test_finish:
+    addi t2, zero, 6
+    halt
+    fail
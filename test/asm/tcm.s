@@ -0,0 +1,157 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: tcm.s
+#
+# ------------------------------------------------------------------------------------------------
+# |                                                                                              |
+# | Tightly coupled data memory test (loads, stores and back-to-back accesses).                  |
+# | Needs the TCM: make clean test/asm/tcm TCM_ENABLE=1                                          |
+# | If everything runs correctly, the first register of the peripheral test module               |
+# | should always be zero, except during the first test, which checks the assert macro itself.   |
+# | Note: This condition is necessary, but not sufficient to prove coreectness.                  |
+# |                                                                                              |
+# | Register allocation:                                                                         |
+# |     x0  (zero): hardwired 0                                                                  |
+# |     x5  (t0):   reserved for macro use                                                       |
+# |     x6  (t1):   constant 1                                                                   |
+# |     x7  (t2):   test case number                                                             |
+# |     x18 (s2):   constant 0x20000<<2 (tightly coupled memory address)                         |
+# |     x19 (s3):   address of the last word of the tightly coupled memory                       |
+# |     x20 (s4):   temporary register                                                           |
+# |     x28 (t3):   constant 0x120000<<2 (test peripheral address)                               |
+# |     x29 (t4):   constant address of var                                                      |
+# |     x30 (t5):   temporary register                                                           |
+# |     x31 (t6):   temporary register                                                           |
+# |     x21 (s5):   temporary register for interrupt                                             |
+# |     x22 (s6):   temporary register for interrupt                                             |
+# |                                                                                              |
+# ------------------------------------------------------------------------------------------------
+
+.macro pass
+    sw zero, 0(t3)
+.endm
+
+.macro fail
+    sw t1, 0(t3)
+.endm
+
+.macro halt
+    addi t0, zero, 2
+    sw   t0, 0(t3)
+.endm
+
+.macro interrupt delay=1
+    lui  t0,     %hi(\delay)
+    addi t0, t0, %lo(\delay)
+    sw   t0, 4(t3)
+.endm
+
+.macro assert_equal r1:req, r2:req
+    sub  t0, \r1, \r2
+    sltu t0, zero, t0
+    sw   t0, 0(t3)
+.endm
+
+.macro assert_value reg:req, value: req
+    lui  t0,     %hi(\value)
+    addi t0, t0, %lo(\value)
+    assert_equal t0, \reg
+.endm
+
+.macro flush_pipeline
+    nop
+    nop
+    nop
+    nop
+    nop
+.endm
+
+# ------------------------------------------------------------------------------------------------
+# |                                          Test entry!                                         |
+# ------------------------------------------------------------------------------------------------
+.global __reset
+__reset:
+
+test_init:
+    addi t1, zero, 1              # t1 = 1
+    addi t2, zero, 0              # t2 = test case number
+    lui  t3, %hi(0x120000<<2)     # t3 = peripheral test address
+    lui  t4, %hi(var)             # t4 = variable address
+    lui  s2, %hi(0x20000<<2)      # s2 = tcm address
+    flush_pipeline
+    addi t3, t3, %lo(0x120000<<2)
+    addi t4, t4, %lo(var)
+    addi s2, s2, %lo(0x20000<<2)
+
+test_fail:
+    addi t2, zero, 1
+    assert_value zero, 1
+
+# -----------------------------------------------
+# Word access
+test_sw_lw:
+    addi t2, zero, 2
+    lui  t5,     %hi(0xcafebabe)
+    addi t5, t5, %lo(0xcafebabe)
+    sw   t5, 0(s2)
+    lw   t6, 0(s2)
+    assert_value t6, 0xcafebabe
+
+# -----------------------------------------------
+# Byte and halfword access
+test_sb_sh:
+    addi t2, zero, 3
+    lui  t5,     %hi(0xdeadbeef)
+    addi t5, t5, %lo(0xdeadbeef)
+    sb   t5, 0(s2)
+    lw   t6, 0(s2)
+    assert_value t6, 0xcafebaef
+    sh   t5, 2(s2)
+    lw   t6, 0(s2)
+    assert_value t6, 0xbeefbaef
+    lbu  t6, 3(s2)
+    assert_value t6, 0x000000be
+    lh   t6, 2(s2)
+    assert_value t6, 0xffffbeef
+
+# -----------------------------------------------
+# Back-to-back accesses to the last word of the TCM
+test_back_to_back:
+    addi t2, zero, 4
+    lui  s3,     %hi((0x20000 + 0x400 - 1)<<2)
+    addi s3, s3, %lo((0x20000 + 0x400 - 1)<<2)
+    sw   t1, 0(s3)
+    sw   t5, 4(s2)
+    lw   t6, 0(s3)
+    lw   s4, 4(s2)
+    assert_value t6, 1
+    assert_equal s4, t5
+
+# -----------------------------------------------
+# Alternating TCM and RAM accesses
+test_tcm_ram:
+    addi t2, zero, 5
+    lw   t6, 0(t4)
+    sw   t6, 8(s2)
+    lw   t5, 8(s2)
+    sw   t5, 4(t4)
+    lw   t6, 4(t4)
+    assert_value t6, 0x12345678
+    # tcm content is unchanged by ram accesses
+    lw   t6, 0(s3)
+    assert_value t6, 1
+
+# ------------------------------------------------------------------------------------------------
+# |                                          Test done!                                          |
+# ------------------------------------------------------------------------------------------------
+test_finish:
+    addi t2, zero, 6
+    halt
+    fail
+
+    .align 4
+var:
+    .word 0x12345678
+    .word 0x00000000
@@ -0,0 +1,339 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: timer.s
+#
+# ------------------------------------------------------------------------------------------------
+# |                                                                                              |
+# | Timer peripheral test (periodic mode, mtimeh latch and compare channels).                    |
+# | If everything runs correctly, the first register of the peripheral test module               |
+# | should always be zero, except during the first test, which checks the assert macro itself.   |
+# | Note: This condition is necessary, but not sufficient to prove coreectness.                  |
+# |                                                                                              |
+# | Register allocation:                                                                         |
+# |     x0  (zero): hardwired 0                                                                  |
+# |     x5  (t0):   reserved for macro use                                                       |
+# |     x6  (t1):   constant 1                                                                   |
+# |     x7  (t2):   test case number                                                             |
+# |     x18 (s2):   constant 0x85000<<2 (timer peripheral address)                               |
+# |     x28 (t3):   constant 0x120000<<2 (test peripheral address)                               |
+# |     x29 (t4):   constant address of var                                                      |
+# |     x30 (t5):   temporary register                                                           |
+# |     x31 (t6):   temporary register                                                           |
+# |     x21 (s5):   temporary register for interrupt                                             |
+# |     x22 (s6):   temporary register for interrupt                                             |
+# |                                                                                              |
+# ------------------------------------------------------------------------------------------------
+
+.macro pass
+    sw zero, 0(t3)
+.endm
+
+.macro fail
+    sw t1, 0(t3)
+.endm
+
+.macro halt
+    addi t0, zero, 2
+    sw   t0, 0(t3)
+.endm
+
+.macro assert_equal r1:req, r2:req
+    sub  t0, \r1, \r2
+    sltu t0, zero, t0
+    sw   t0, 0(t3)
+.endm
+
+.macro assert_value reg:req, value: req
+    lui  t0,     %hi(\value)
+    addi t0, t0, %lo(\value)
+    assert_equal t0, \reg
+.endm
+
+.macro flush_pipeline
+    nop
+    nop
+    nop
+    nop
+    nop
+.endm
+
+.macro wait cycles:req
+    addi t5, zero, \cycles
+    1:
+        addi t5, t5, -1
+        bne  zero, t5, 1b
+.endm
+
+# Timer register byte offsets
+.equ TIMER_STATUS,       (0 << 2)
+.equ TIMER_MTIME,        (1 << 2)
+.equ TIMER_MTIMEH,       (2 << 2)
+.equ TIMER_MTIMECMP,     (3 << 2)
+.equ TIMER_MTIMECMPH,    (4 << 2)
+.equ TIMER_MTIMECTRL,    (5 << 2)
+.equ TIMER_MTIMEPERIOD,  (6 << 2)
+.equ TIMER_PENDING,      (7 << 2)
+.equ TIMER_CH0_CTRL,     (8 << 2)
+.equ TIMER_CH0_PERIOD,   (9 << 2)
+.equ TIMER_CH0_COMPARE,  (10 << 2)
+.equ TIMER_CH0_COUNTER,  (11 << 2)
+.equ TIMER_CH1_CTRL,     (12 << 2)
+.equ TIMER_CH1_PERIOD,   (13 << 2)
+.equ TIMER_CH1_COMPARE,  (14 << 2)
+.equ TIMER_CH1_COUNTER,  (15 << 2)
+.equ TIMER_MTIMEH_LATCHED, (24 << 2)
+
+.global __reset
+__reset:
+    beq  zero, zero, test_init
+    # jump to reset if this code snipped reached
+    flush_pipeline
+    beq  zero, zero, __reset
+
+# ------------------------------------------------------------------------------------------------
+# |                            Helperfunctions and Interrupt-handlers!                           |
+# ------------------------------------------------------------------------------------------------
+# HELPERFUNCTIONS AND INTERRUPT HANDLERS
+
+# periodic timer interrupt handler (no re-arming, only acknowledge)
+irq_handler_periodic:
+    # check if timer interrupt triggered
+    csrr s5, mcause
+    assert_value s5, ((1<<31) + 7)
+    # count down interrupt variable
+    lui  s6,     %hi(interrupt_var)
+    addi s6, s6, %lo(interrupt_var)
+    lw   s5, 0(s6)
+    addi s5, s5, -1
+    sw   s5, 0(s6)
+    # disable periodic mode after some interrupts
+    bne  s5, x0, irq_periodic_ack_and_return
+    sw   zero, TIMER_MTIMECTRL(s2)
+    addi s6, zero, 1
+    slli s6, s6, 7
+    csrc mie, s6
+    # signal all interrupts done
+    lui  s5,     %hi(0xdeadbeef)
+    addi s5, s5, %lo(0xdeadbeef)
+    lui  s6,     %hi(interrupt_var)
+    addi s6, s6, %lo(interrupt_var)
+    sw   s5, 0(s6)
+    irq_periodic_ack_and_return:
+    # acknowledge mtime event
+    addi s5, zero, 1
+    sw   s5, TIMER_PENDING(s2)
+    mret
+    # jump to reset if this code snipped reached
+    flush_pipeline
+    beq  zero, zero, __reset
+
+# compare channel interrupt handler
+irq_handler_channel:
+    # check if timer interrupt triggered
+    csrr s5, mcause
+    assert_value s5, ((1<<31) + 7)
+    # count interrupts
+    lui  s6,     %hi(interrupt_var)
+    addi s6, s6, %lo(interrupt_var)
+    lw   s5, 0(s6)
+    addi s5, s5, 1
+    sw   s5, 0(s6)
+    # acknowledge channel 1 compare event
+    addi s5, zero, (1 << 4)
+    sw   s5, TIMER_PENDING(s2)
+    mret
+    # jump to reset if this code snipped reached
+    flush_pipeline
+    beq  zero, zero, __reset
+
+# ------------------------------------------------------------------------------------------------
+# |                                          Test entry!                                         |
+# ------------------------------------------------------------------------------------------------
+test_init:
+    addi t1, zero, 1              # t1 = 1
+    addi t2, zero, 0              # t2 = test case number
+    lui  t3, %hi(0x120000<<2)     # t3 = peripheral test address
+    lui  t4, %hi(var)             # t4 = variable address
+    lui  s2, %hi(0x85000<<2)      # s2 = timer address
+    flush_pipeline
+    addi t3, t3, %lo(0x120000<<2)
+    addi t4, t4, %lo(var)
+    addi s2, s2, %lo(0x85000<<2)
+
+test_fail:
+    addi t2, zero, 1
+    assert_value zero, 1
+
+# -----------------------------------------------
+# Status register reports the number of channels
+test_status:
+    addi t2, zero, 2
+    lw   t5, TIMER_STATUS(s2)
+    srli t5, t5, 8
+    andi t5, t5, 0xff
+    assert_value t5, 4
+
+# -----------------------------------------------
+# Reading mtime latches mtimeh, mtimeh itself is read live
+test_mtimeh:
+    addi t2, zero, 3
+    # mtime = 0x00000005_ffffffc0 (low half overflows soon)
+    addi t5, zero, -64
+    addi t6, zero, 5
+    sw   t5, TIMER_MTIME(s2)
+    sw   t6, TIMER_MTIMEH(s2)
+    # latch upper half before the overflow
+    lw   t5, TIMER_MTIME(s2)
+    wait 100
+    # mtime overflowed into the upper half, the latched value stays 5
+    lw   t6, TIMER_MTIMEH(s2)
+    assert_value t6, 6
+    lw   t6, TIMER_MTIMEH_LATCHED(s2)
+    assert_value t6, 5
+    # a new read of mtime latches the new upper half
+    lw   t5, TIMER_MTIME(s2)
+    lw   t6, TIMER_MTIMEH_LATCHED(s2)
+    assert_value t6, 6
+    # reset counter
+    sw   zero, TIMER_MTIMEH(s2)
+    sw   zero, TIMER_MTIME(s2)
+
+# -----------------------------------------------
+# Periodic mode (auto-reload of mtimecmp)
+test_periodic:
+    addi t2, zero, 4
+    addi t5, zero, 3
+    lui  t6,     %hi(interrupt_var)
+    addi t6, t6, %lo(interrupt_var)
+    sw   t5, 0(t6)
+    flush_pipeline
+    # set interrupt handler
+    lui  t5,     %hi(irq_handler_periodic)
+    addi t5, t5, %lo(irq_handler_periodic)
+    csrw mtvec, t5
+    # interrupt every 60 cycles, without touching mtime
+    addi t5, zero, 60
+    sw   t5, TIMER_MTIMEPERIOD(s2)
+    lw   t6, TIMER_MTIME(s2)
+    add  t6, t6, t5
+    sw   zero, TIMER_MTIMECMPH(s2)
+    sw   t6, TIMER_MTIMECMP(s2)
+    sw   t1, TIMER_PENDING(s2)
+    sw   t1, TIMER_MTIMECTRL(s2)
+    # enable interrupts
+    slli t5, t1, 7
+    csrs mie, t5
+    slli t5, t1, 3
+    csrs mstatus, t5
+    # wait some time
+    wait 150
+    # disable interrupts
+    slli t5, t1, 7
+    csrc mie, t5
+    slli t5, t1, 3
+    csrc mstatus, t5
+    # check interrupt counter
+    lui  t6,     %hi(interrupt_var)
+    addi t6, t6, %lo(interrupt_var)
+    lw   t5, 0(t6)
+    assert_value t5, 0xdeadbeef
+    # periodic mode was switched off by the handler
+    lw   t5, TIMER_MTIMECTRL(s2)
+    assert_value t5, 0
+
+# -----------------------------------------------
+# One-shot channel reload (polling)
+test_channel_oneshot:
+    addi t2, zero, 5
+    # clear all pending bits
+    addi t5, zero, -1
+    sw   t5, TIMER_PENDING(s2)
+    # period 20, oneshot, enable
+    addi t5, zero, 20
+    sw   t5, TIMER_CH0_PERIOD(s2)
+    sw   zero, TIMER_CH0_COUNTER(s2)
+    addi t5, zero, ((1 << 3) | (1 << 0))
+    sw   t5, TIMER_CH0_CTRL(s2)
+    # reading the counter doesn't stop it
+    lw   t5, TIMER_CH0_COUNTER(s2)
+    lw   t6, TIMER_CH0_COUNTER(s2)
+    sltu t6, t5, t6
+    assert_value t6, 1
+    wait 40
+    # channel disabled itself and stopped at 0
+    lw   t5, TIMER_CH0_CTRL(s2)
+    andi t5, t5, 1
+    assert_value t5, 0
+    lw   t5, TIMER_CH0_COUNTER(s2)
+    assert_value t5, 0
+    # reload pending bit of channel 0 is set
+    lw   t5, TIMER_PENDING(s2)
+    andi t5, t5, (1 << 1)
+    assert_value t5, (1 << 1)
+    # clear it again
+    addi t5, zero, (1 << 1)
+    sw   t5, TIMER_PENDING(s2)
+    lw   t5, TIMER_PENDING(s2)
+    andi t5, t5, (1 << 1)
+    assert_value t5, 0
+
+# -----------------------------------------------
+# Compare channel interrupt
+test_channel_interrupt:
+    addi t2, zero, 6
+    lui  t6,     %hi(interrupt_var)
+    addi t6, t6, %lo(interrupt_var)
+    sw   zero, 0(t6)
+    flush_pipeline
+    # set interrupt handler
+    lui  t5,     %hi(irq_handler_channel)
+    addi t5, t5, %lo(irq_handler_channel)
+    csrw mtvec, t5
+    # make sure the mtime interrupt stays off
+    addi t5, zero, -1
+    sw   t5, TIMER_MTIMECMPH(s2)
+    sw   t5, TIMER_PENDING(s2)
+    # period 100, compare 10, compare interrupt enabled
+    addi t5, zero, 100
+    sw   t5, TIMER_CH1_PERIOD(s2)
+    addi t5, zero, 10
+    sw   t5, TIMER_CH1_COMPARE(s2)
+    sw   zero, TIMER_CH1_COUNTER(s2)
+    addi t5, zero, ((1 << 2) | (1 << 0))
+    sw   t5, TIMER_CH1_CTRL(s2)
+    # enable interrupts
+    slli t5, t1, 7
+    csrs mie, t5
+    slli t5, t1, 3
+    csrs mstatus, t5
+    # wait for roughly 2.5 periods
+    wait 120
+    # stop channel
+    sw   zero, TIMER_CH1_CTRL(s2)
+    # disable interrupts
+    slli t5, t1, 7
+    csrc mie, t5
+    slli t5, t1, 3
+    csrc mstatus, t5
+    # at least two compare interrupts were taken
+    lui  t6,     %hi(interrupt_var)
+    addi t6, t6, %lo(interrupt_var)
+    lw   t5, 0(t6)
+    sltiu t5, t5, 2
+    assert_value t5, 0
+
+# ------------------------------------------------------------------------------------------------
+# |                                          Test done!                                          |
+# ------------------------------------------------------------------------------------------------
+test_finish:
+    addi t2, zero, 7
+    halt
+    fail
+
+    .align 4
+var:
+    .word 0xcafebabe
+interrupt_var:
+    .word 0xdeadbeef
@@ -0,0 +1,118 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: compare.py
+#
+# Collects the "REPORT <key> <value>" lines of the benchmark runs and prints a comparison
+# table against the stored baseline (test/bench/baseline.json).
+#
+# Usage:
+#   compare.py [--baseline FILE] [--threshold PERCENT] [--allow-missing-baseline] report.txt...
+#   compare.py --write-baseline FILE report.txt...
+#
+# The benchmark name is the name of the directory containing report.txt.
+# Exit code 1 if a cost key (cycles, instructions, latency) got worse by more than the
+# threshold (or grew from 0) or a checksum ("chk") changed, and if a benchmark or a key of the
+# baseline is missing in the reports, i.e. the target can be used in CI.
+# A missing baseline file or a checksum without baseline value is an error as well (the results
+# of the workloads would not be validated), unless --allow-missing-baseline is given.
+
+import argparse
+import json
+import os
+import sys
+
+# Keys where a higher value is a regression
+COST_KEYS = {"cycl", "inst", "ucyc", "scyc", "scrn", "lmin", "lmax"}
+
+# Keys that must match exactly (results of the workload)
+CHECK_KEYS = {"chk"}
+
+
+def read_reports(paths):
+    results = {}
+    for path in paths:
+        name = os.path.basename(os.path.dirname(os.path.abspath(path)))
+        values = {}
+        with open(path) as report:
+            for line in report:
+                fields = line.split()
+                if len(fields) == 3 and fields[0] == "REPORT":
+                    values[fields[1]] = int(fields[2])
+        results[name] = values
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare benchmark reports against a baseline")
+    parser.add_argument("reports", nargs="+", help="report.txt files")
+    parser.add_argument("--baseline", default="test/bench/baseline.json")
+    parser.add_argument("--write-baseline", metavar="FILE", help="store the reports as new baseline")
+    parser.add_argument("--threshold", type=float, default=2.0, help="allowed regression in percent")
+    parser.add_argument("--allow-missing-baseline", action="store_true",
+                        help="don't fail without baseline file or baseline checksums")
+    args = parser.parse_args()
+
+    results = read_reports(args.reports)
+
+    if args.write_baseline:
+        with open(args.write_baseline, "w") as baseline_file:
+            json.dump(results, baseline_file, indent=4, sort_keys=True)
+            baseline_file.write("\n")
+        print(f"Baseline written to {args.write_baseline}")
+        return 0
+
+    failed = False
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+    else:
+        print(f"No baseline found ({args.baseline}), run 'make bench-baseline' to create one")
+        failed = not args.allow_missing_baseline
+
+    print(f"{'benchmark':<12} {'key':<6} {'baseline':>12} {'current':>12} {'delta':>9}")
+    print("-" * 55)
+    for name in sorted(results):
+        for key in sorted(results[name]):
+            current = results[name][key]
+            reference = baseline.get(name, {}).get(key)
+            status = ""
+            if reference is None:
+                delta = "new"
+            elif reference == 0:
+                delta = "-" if current == 0 else "inf"
+                if key in COST_KEYS and current > 0:
+                    status = "  REGRESSION"
+                    failed = True
+            else:
+                percent = 100.0 * (current - reference) / reference
+                delta = f"{percent:+.2f}%"
+                if key in COST_KEYS and percent > args.threshold:
+                    status = "  REGRESSION"
+                    failed = True
+            if key in CHECK_KEYS and reference is None and not args.allow_missing_baseline:
+                status = "  UNCHECKED"
+                failed = True
+            if key in CHECK_KEYS and reference is not None and current != reference:
+                status = "  MISMATCH"
+                failed = True
+            reference_text = "-" if reference is None else str(reference)
+            print(f"{name:<12} {key:<6} {reference_text:>12} {current:>12} {delta:>9}{status}")
+        # stopped before reporting everything
+        for key in sorted(set(baseline.get(name, {})) - set(results[name])):
+            print(f"{name:<12} {key:<6} missing in current run  MISSING")
+            failed = True
+
+    missing = sorted(set(baseline) - set(results))
+    for name in missing:
+        # crashed, timed out or removed without updating the baseline
+        print(f"{name:<12} missing in current run  MISSING")
+        failed = True
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,192 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: coremark.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | CoreMark-style workload: linked list processing, small matrix operations, a state machine    |
+// | parser and CRC16 over all results (same kernel mix as CoreMark, reduced data set).           |
+// |                                                                                              |
+// | Reports: cycl, inst, chk (CRC16 of all results, must not change between revisions)           |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "bench.h"
+
+#define ITERATIONS  10
+#define LIST_SIZE   32
+#define MATRIX_SIZE 8
+
+// ------------------------------------------------------------------------------------------------
+// |                                             CRC                                              |
+// ------------------------------------------------------------------------------------------------
+uint16_t crc16(uint16_t crc, uint16_t data) {
+    for (int i = 0; i < 16; i++) {
+        uint16_t bit = (crc ^ data) & 1;
+        data >>= 1;
+        crc >>= 1;
+        if (bit) { crc ^= 0xA001; }
+    }
+    return crc;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                         Linked list                                          |
+// ------------------------------------------------------------------------------------------------
+typedef struct list_node {
+    struct list_node *next;
+    int16_t value;
+    int16_t index;
+} list_node_t;
+
+list_node_t nodes[LIST_SIZE];
+
+list_node_t *listInit(uint16_t seed) {
+    for (int i = 0; i < LIST_SIZE; i++) {
+        nodes[i].next  = (i + 1 < LIST_SIZE) ? &nodes[i + 1] : 0;
+        seed = seed * 25173 + 13849;
+        nodes[i].value = seed >> 4;
+        nodes[i].index = i;
+    }
+    return &nodes[0];
+}
+
+list_node_t *listReverse(list_node_t *head) {
+    list_node_t *reversed = 0;
+    while (head) {
+        list_node_t *next = head->next;
+        head->next = reversed;
+        reversed = head;
+        head = next;
+    }
+    return reversed;
+}
+
+// insertion sort by value
+list_node_t *listSort(list_node_t *head) {
+    list_node_t *sorted = 0;
+    while (head) {
+        list_node_t *next = head->next;
+        list_node_t **position = &sorted;
+        while (*position && (*position)->value < head->value) {
+            position = &(*position)->next;
+        }
+        head->next = *position;
+        *position = head;
+        head = next;
+    }
+    return sorted;
+}
+
+uint16_t listBench(uint16_t seed, uint16_t crc) {
+    list_node_t *list = listSort(listReverse(listInit(seed)));
+    for (list_node_t *node = list; node; node = node->next) {
+        crc = crc16(crc, node->index);
+    }
+    return crc;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Matrix                                            |
+// ------------------------------------------------------------------------------------------------
+int16_t matrix_a[MATRIX_SIZE][MATRIX_SIZE];
+int16_t matrix_b[MATRIX_SIZE][MATRIX_SIZE];
+int32_t matrix_c[MATRIX_SIZE][MATRIX_SIZE];
+
+uint16_t matrixBench(uint16_t seed, uint16_t crc) {
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            seed = seed * 25173 + 13849;
+            matrix_a[i][j] = (seed >> 8) & 0xFF;
+            matrix_b[i][j] = (seed >> 4) & 0x7F;
+        }
+    }
+    // C = A * B
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            int32_t sum = 0;
+            for (int k = 0; k < MATRIX_SIZE; k++) {
+                sum += (int32_t) matrix_a[i][k] * matrix_b[k][j];
+            }
+            matrix_c[i][j] = sum;
+        }
+    }
+    // A += constant, extract bits
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            matrix_a[i][j] += 7;
+            crc = crc16(crc, (uint16_t)(matrix_c[i][j] >> 3) ^ matrix_a[i][j]);
+        }
+    }
+    return crc;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                        State machine                                         |
+// ------------------------------------------------------------------------------------------------
+typedef enum { STATE_START, STATE_INT, STATE_FLOAT, STATE_EXPONENT, STATE_INVALID, STATE_COUNT } state_t;
+
+const char *inputs = "5012,1.5,-17,+3.2e4,abc,0.001,7e-2,..,42,-0.5E3,x1,1234567,";
+
+uint16_t stateBench(uint16_t crc) {
+    uint16_t counts[STATE_COUNT] = {0};
+    state_t state = STATE_START;
+    for (const char *c = inputs; *c; c++) {
+        if (*c == ',') {
+            counts[state]++;
+            state = STATE_START;
+            continue;
+        }
+        int digit = *c >= '0' && *c <= '9';
+        switch (state) {
+            case STATE_START:
+                state = (digit || *c == '+' || *c == '-') ? STATE_INT : (*c == '.') ? STATE_FLOAT : STATE_INVALID;
+                break;
+            case STATE_INT:
+                if (*c == '.')                  { state = STATE_FLOAT; }
+                else if (*c == 'e' || *c == 'E') { state = STATE_EXPONENT; }
+                else if (!digit)                { state = STATE_INVALID; }
+                break;
+            case STATE_FLOAT:
+                if (*c == 'e' || *c == 'E')      { state = STATE_EXPONENT; }
+                else if (!digit)                { state = STATE_INVALID; }
+                break;
+            case STATE_EXPONENT:
+                if (!digit && *c != '-' && *c != '+') { state = STATE_INVALID; }
+                break;
+            default:
+                break;
+        }
+    }
+    for (int i = 0; i < STATE_COUNT; i++) {
+        crc = crc16(crc, counts[i]);
+    }
+    return crc;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    bench_counter_t counter;
+    uint16_t crc = 0;
+
+    benchStart(&counter);
+    for (int i = 0; i < ITERATIONS; i++) {
+        crc = listBench(i, crc);
+        crc = matrixBench(i, crc);
+        crc = stateBench(crc);
+    }
+    benchStop(&counter);
+
+    benchReportCounter(&counter);
+    benchReport("chk", crc);
+    return 0;
+}
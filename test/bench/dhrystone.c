@@ -0,0 +1,218 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: dhrystone.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Dhrystone-style workload: record copies through pointers, string copy/compare, enumeration   |
+// | and integer arithmetic in small procedures (structure of Dhrystone 2.1, no timing code).     |
+// |                                                                                              |
+// | Reports: cycl, inst, chk (checksum of the final state)                                       |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define RUNS 200
+
+typedef enum { IDENT_1, IDENT_2, IDENT_3, IDENT_4, IDENT_5 } enumeration_t;
+
+typedef struct record {
+    struct record *next;
+    enumeration_t  discr;
+    enumeration_t  enum_comp;
+    int            int_comp;
+    char           str_comp[31];
+} record_t;
+
+record_t record_glob, record_next;
+record_t *record_ptr = &record_glob;
+
+int  int_glob;
+int  bool_glob;
+char char_1_glob, char_2_glob;
+int  array_1_glob[50];
+int  array_2_glob[50][50];
+
+// ------------------------------------------------------------------------------------------------
+// |                                          Procedures                                          |
+// ------------------------------------------------------------------------------------------------
+__attribute__((noinline))
+int func1(char char_1, char char_2) {
+    char char_loc_1 = char_1;
+    char char_loc_2 = char_loc_1;
+    if (char_loc_2 != char_2) {
+        return IDENT_1;
+    }
+    char_1_glob = char_loc_1;
+    return IDENT_2;
+}
+
+__attribute__((noinline))
+int func2(const char *str_1, const char *str_2) {
+    int int_loc = 2;
+    char char_loc = 'A';
+    while (int_loc <= 2) {
+        if (func1(str_1[int_loc], str_2[int_loc + 1]) == IDENT_1) {
+            char_loc = 'A';
+            int_loc += 1;
+        }
+    }
+    if (char_loc >= 'W' && char_loc < 'Z') {
+        int_loc = 7;
+    }
+    if (char_loc == 'R') {
+        return 1;
+    }
+    if (strcmp(str_1, str_2) > 0) {
+        int_glob = int_loc + 7;
+        return 1;
+    }
+    return 0;
+}
+
+__attribute__((noinline))
+int func3(enumeration_t enum_par) {
+    return enum_par == IDENT_3;
+}
+
+__attribute__((noinline))
+void proc7(int int_1, int int_2, int *int_out) {
+    *int_out = int_2 + int_1 + 2;
+}
+
+__attribute__((noinline))
+void proc8(int array_1[50], int array_2[50][50], int int_1, int int_2) {
+    int int_loc = int_1 + 5;
+    array_1[int_loc] = int_2;
+    array_1[int_loc + 1] = array_1[int_loc];
+    array_1[int_loc + 30] = int_loc;
+    for (int index = int_loc; index <= int_loc + 1; index++) {
+        array_2[int_loc][index] = int_loc;
+    }
+    array_2[int_loc][int_loc - 1] += 1;
+    array_2[int_loc + 20][int_loc] = array_1[int_loc];
+    int_glob = 5;
+}
+
+__attribute__((noinline))
+void proc6(enumeration_t enum_in, enumeration_t *enum_out) {
+    *enum_out = enum_in;
+    if (!func3(enum_in)) {
+        *enum_out = IDENT_4;
+    }
+    switch (enum_in) {
+        case IDENT_1: *enum_out = IDENT_1; break;
+        case IDENT_2: *enum_out = (int_glob > 100) ? IDENT_1 : IDENT_4; break;
+        case IDENT_3: *enum_out = IDENT_2; break;
+        case IDENT_4: break;
+        case IDENT_5: *enum_out = IDENT_3; break;
+    }
+}
+
+__attribute__((noinline))
+void proc3(record_t **record_out) {
+    if (record_ptr != 0) {
+        *record_out = record_ptr->next;
+    }
+    proc7(10, int_glob, &record_ptr->int_comp);
+}
+
+__attribute__((noinline))
+void proc1(record_t *record_in) {
+    record_t *next = record_in->next;
+    *record_in->next = *record_ptr;
+    record_in->int_comp = 5;
+    next->int_comp = record_in->int_comp;
+    next->next = record_in->next;
+    proc3(&next->next);
+    if (next->discr == IDENT_1) {
+        next->int_comp = 6;
+        proc6(record_in->enum_comp, &next->enum_comp);
+        next->next = record_ptr->next;
+        proc7(next->int_comp, 10, &next->int_comp);
+    }
+    else {
+        *record_in = *record_in->next;
+    }
+}
+
+__attribute__((noinline))
+void proc2(int *int_io) {
+    int int_loc = *int_io + 10;
+    enumeration_t enum_loc = IDENT_2;
+    do {
+        if (char_1_glob == 'A') {
+            int_loc -= 1;
+            *int_io = int_loc - int_glob;
+            enum_loc = IDENT_1;
+        }
+    } while (enum_loc != IDENT_1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    bench_counter_t counter;
+    char str_1_loc[31];
+    char str_2_loc[31];
+    int int_1_loc = 0, int_2_loc = 0, int_3_loc = 0;
+    enumeration_t enum_loc = IDENT_2;
+
+    record_glob.next      = &record_next;
+    record_glob.discr     = IDENT_1;
+    record_glob.enum_comp = IDENT_3;
+    record_glob.int_comp  = 40;
+    strcpy(record_glob.str_comp, "DHRYSTONE PROGRAM, SOME STRING");
+    strcpy(str_1_loc, "DHRYSTONE PROGRAM, 1'ST STRING");
+    array_2_glob[8][7] = 10;
+
+    benchStart(&counter);
+    for (int run = 1; run <= RUNS; run++) {
+        char_1_glob = 'A';
+        char_2_glob = 'B';
+        bool_glob = 1;
+        int_1_loc = 2;
+        int_2_loc = 3;
+        strcpy(str_2_loc, "DHRYSTONE PROGRAM, 2'ND STRING");
+        enum_loc = IDENT_2;
+        bool_glob = !func2(str_1_loc, str_2_loc);
+        while (int_1_loc < int_2_loc) {
+            int_3_loc = (int_1_loc << 2) + int_1_loc - int_2_loc;
+            proc7(int_1_loc, int_2_loc, &int_3_loc);
+            int_1_loc += 1;
+        }
+        proc8(array_1_glob, array_2_glob, int_1_loc, int_3_loc);
+        proc1(record_ptr);
+        for (char char_index = 'A'; char_index <= char_2_glob; char_index++) {
+            if (enum_loc == func1(char_index, 'C')) {
+                proc6(IDENT_1, &enum_loc);
+                strcpy(str_2_loc, "DHRYSTONE PROGRAM, 3'RD STRING");
+                int_2_loc = run;
+                int_glob = run;
+            }
+        }
+        int_2_loc = int_2_loc * int_1_loc;
+        int_1_loc = int_2_loc - int_3_loc;
+        int_2_loc = (int_2_loc << 3) - int_2_loc - int_3_loc;
+        proc2(&int_1_loc);
+    }
+    benchStop(&counter);
+
+    uint32_t checksum = int_glob + bool_glob + (char_1_glob << 8) + (char_2_glob << 16)
+                      + array_1_glob[8] + array_2_glob[8][7] + record_glob.int_comp
+                      + int_1_loc + (int_2_loc << 4) + (int_3_loc << 8) + enum_loc + str_2_loc[20];
+
+    benchReportCounter(&counter);
+    benchReport("chk", checksum);
+    return 0;
+}
@@ -0,0 +1,44 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: fbfill.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Frame buffer fill: typical UI redraw over the VGA Wishbone port (graphics.h).                |
+// |                                                                                              |
+// | Reports: cycl, inst (whole redraw), scrn (fillScreen only)                                   |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "graphics.h"
+
+int main() {
+    bench_counter_t screen;
+    benchStart(&screen);
+    fillScreen(VGA_COLOR_BLUE);
+    benchStop(&screen);
+
+    bench_counter_t counter;
+    benchStart(&counter);
+    // window with title bar, some buttons and text
+    fillRect(40, 60, 521, 401, VGA_COLOR_LIGHT_GRAY);
+    fillRect(40, 60, 521, 13, VGA_COLOR_GRAY);
+    drawText(44, 64, "HADES-V BENCHMARK", VGA_COLOR_WHITE, GRAPHICS_NO_COLOR);
+    for (int i = 0; i < 8; i++) {
+        fillRect(100 + i * 40, 83, 75, 30, VGA_COLOR_CYAN);
+        drawText(112 + i * 40, 90, "BUTTON", VGA_COLOR_BLACK, VGA_COLOR_CYAN);
+    }
+    benchStop(&counter);
+
+    benchReportCounter(&counter);
+    benchReport("scrn", screen.cycles);
+    return 0;
+}
@@ -0,0 +1,66 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: irqlat.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Interrupt latency: cycles from the external interrupt of the test peripheral to the first    |
+// | instruction of the C interrupt handler (including the register save of the prologue).       |
+// |                                                                                              |
+// | Reports: lmin, lmax (latency in cycles), cycl, inst (all repetitions)                        |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "helperfunctions.h"
+
+#define REPETITIONS 8
+#define DELAY       64
+
+volatile uint32_t interrupt_cycle;
+volatile uint32_t interrupt_taken;
+
+__attribute__((interrupt))
+void interrupt() {
+    interrupt_cycle = readCycles();
+    // disable the interrupt of the test peripheral
+    *TEST_INTERRUPT_ADDRESS = 0;
+    interrupt_taken = 1;
+}
+
+int main() {
+    asm("csrw mtvec, %0": : "r"(interrupt));
+    enableDisable_externalInterrupts(1);
+    enableDisable_machineInterrupts(1);
+
+    uint32_t latency_min = 0xFFFFFFFF;
+    uint32_t latency_max = 0;
+
+    bench_counter_t counter;
+    benchStart(&counter);
+    for (int i = 0; i < REPETITIONS; i++) {
+        interrupt_taken = 0;
+        // the interrupt is raised DELAY cycles after the write
+        uint32_t start = readCycles();
+        *TEST_INTERRUPT_ADDRESS = DELAY;
+        while (!interrupt_taken);
+        uint32_t latency = interrupt_cycle - start - DELAY;
+        if (latency < latency_min) { latency_min = latency; }
+        if (latency > latency_max) { latency_max = latency; }
+    }
+    benchStop(&counter);
+
+    enableDisable_machineInterrupts(0);
+
+    benchReport("lmin", latency_min);
+    benchReport("lmax", latency_max);
+    benchReportCounter(&counter);
+    return 0;
+}
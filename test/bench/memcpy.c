@@ -0,0 +1,54 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: memcpy.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Memory bandwidth: memcpy and memset of 4 KB buffers in RAM (aligned and unaligned).          |
+// |                                                                                              |
+// | Reports: cycl, inst (aligned memcpy), ucyc (unaligned memcpy), scyc (memset), byte (size)    |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define BUFFER_SIZE 4096
+
+uint32_t source[BUFFER_SIZE / 4 + 1];
+uint32_t dest[BUFFER_SIZE / 4 + 1];
+
+int main() {
+    bench_counter_t counter;
+
+    for (int i = 0; i < BUFFER_SIZE / 4; i++) {
+        source[i] = i;
+    }
+
+    benchStart(&counter);
+    memcpy(dest, source, BUFFER_SIZE);
+    benchStop(&counter);
+    benchReportCounter(&counter);
+
+    bench_counter_t unaligned;
+    benchStart(&unaligned);
+    memcpy((uint8_t *) dest + 1, source, BUFFER_SIZE);
+    benchStop(&unaligned);
+    benchReport("ucyc", unaligned.cycles);
+
+    bench_counter_t set;
+    benchStart(&set);
+    memset(dest, 0, BUFFER_SIZE);
+    benchStop(&set);
+    benchReport("scyc", set.cycles);
+
+    benchReport("byte", BUFFER_SIZE);
+    return 0;
+}
@@ -0,0 +1,36 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: uart.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | UART throughput: formatted output with uartPrintf (bounded by the baud rate).                |
+// |                                                                                              |
+// | Reports: cycl, inst, byte (characters sent)                                                  |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "uart.h"
+
+int main() {
+    bench_counter_t counter;
+    int bytes = 0;
+
+    benchStart(&counter);
+    for (int i = 0; i < 4; i++) {
+        bytes += uartPrintf("line %d: 0x%08x %s\n", i, 0xCAFE0000 + i, "hades-v");
+    }
+    benchStop(&counter);
+
+    benchReportCounter(&counter);
+    benchReport("byte", bytes);
+    return 0;
+}
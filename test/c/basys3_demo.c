@@ -41,6 +41,7 @@
 
 #include "peripherals.h"
 #include "helperfunctions.h"
+#include "lockfree.h"
 
 // uncomment the following line to simply increment "glob_value" after some cpu cycles
 #define USE_TIMER_INTERRUPT_TO_INCREMENT_GLOB_VALUE
@@ -48,6 +49,9 @@
 uint32_t    glob_value = 0;
 const char* uart_transmit_message = "Transmitting char by char using interrupts seems to work!\n";
 
+// filled by main, emptied by the UART interrupt (no interrupt masking needed)
+QUEUE_DEFINE(uart_tx_queue, 64);
+
 enum Test {
     TEST_LEDS,
     TEST_LEDS_WALK,
@@ -100,23 +104,20 @@ void signalUartErrorOnLeds(uint8_t tx_status, uint8_t rx_status) {
 // ------------------------------------------------------------------------------------------------
 void handleTimerInterrupt() {
     incrementGlobValue();
-    // reset counter
-    *TIMER_MTIME_ADDRESS  = 0;
-    *TIMER_MTIMEH_ADDRESS = 0;
+    // acknowledge interrupt (the timer re-arms itself in periodic mode)
+    clearTimerPending(1<<TIMER_PENDING_IDX_MTIME);
 }
 void handleExternalInterrupt() {
-    static uint8_t  tx_char_idx = 0;
     // check uart transmit interrupt
     uint8_t uart_tx_status = *UART_TX_STATUS_ADDRESS;
     uint8_t uart_tx_status_mask = (1<<UART_TX_STATUS_IDX_IE) | (1<<UART_TX_STATUS_IDX_EMPTY);
     if ((uart_tx_status & uart_tx_status_mask) == uart_tx_status_mask) {
         // transmit next char
-        if (tx_char_idx < str_length(uart_transmit_message)) {
-            *UART_BUFFER_ADDRESS = uart_transmit_message[tx_char_idx];
-            tx_char_idx++;
+        uint8_t tx_char;
+        if (queuePop(&uart_tx_queue, &tx_char)) {
+            *UART_BUFFER_ADDRESS = tx_char;
         } else {
-            enableDisable_uartInterrupts(0, 0); // (enabled again after some time)
-            tx_char_idx = 0;
+            enableDisable_uartInterrupts(0, 0); // (enabled again by the next message)
         }
     }
     // check uart receive interrupt
@@ -247,12 +248,21 @@ void test_uart_echo() {
 
 void test_uart_send_interrupt() {
     static uint32_t last_glob_val = 0;
-    // enable interrupts after some time
-    if (last_glob_val != glob_value) {
+    static int      tx_char_idx = 0;
+    // queue the message again after some time
+    if (last_glob_val != glob_value && tx_char_idx == 0) {
         last_glob_val = glob_value;
+        tx_char_idx = str_length(uart_transmit_message);
+    }
+    // hand over as many chars as fit, the interrupt handler sends them
+    if (tx_char_idx > 0) {
+        const char *remaining = uart_transmit_message + str_length(uart_transmit_message) - tx_char_idx;
+        while (tx_char_idx > 0 && queuePush(&uart_tx_queue, *remaining)) {
+            remaining++;
+            tx_char_idx--;
+        }
         enableDisable_uartInterrupts(0, 1);
     }
-    // nothing else done here (see interrupt handler)
 }
 
 void test_uart_echo_interrupt() {
@@ -338,8 +348,7 @@ void main() {
     // Set timer interrupt every 0.5 second
     uint32_t ns_per_cycle = *TIMER_STATUS_ADDRESS & 0xFF;
     uint32_t cycles_per_second = 500000000 / ns_per_cycle;
-    *TIMER_MTIMECMP_ADDRESS  = cycles_per_second;
-    *TIMER_MTIMECMPH_ADDRESS = 0;
+    setupPeriodicTimer(cycles_per_second);
     enableDisable_timerInterrupts(1);
 #endif
 
@@ -373,7 +382,7 @@ void main() {
                 test_nr++;
                 if (test_nr >= TEST_DUMMY_FINAL) { test_nr = 0; }
                 // Setup test
-                enableDisable_machineInterrupts(0);
+                uint32_t interrupt_state = interruptsSave();
                 enableDisable_externalInterrupts(0);
                 enableDisable_uartInterrupts(0, 0);
                 *LEDS_ADDRESS     = 0;
@@ -406,7 +415,7 @@ void main() {
                         test_nr = 0;
                         break;
                 }
-                enableDisable_machineInterrupts(1);
+                interruptsRestore(interrupt_state);
             }
             // update previous button state
             if (button_east_state_prev != button_east_state_now) {
@@ -0,0 +1,139 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: graphics.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Test of the batched drawing functions (graphics.h).                                          |
+// |                                                                                              |
+// | Every shape is drawn twice: once with the batched function in the left half of the screen   |
+// | and once pixel by pixel with setPixel in the right half. Both halves are compared word by    |
+// | word. The cycles of both variants are stored in "bench_cycles" (reference, batched).         |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "peripherals.h"
+#include "helperfunctions.h"
+#include "graphics.h"
+#include "test.h"
+
+// Offset of the reference drawing (multiple of 8 => same alignment within the words)
+#define REFERENCE_OFFSET 320
+
+enum Bench {
+    BENCH_RECT,
+    BENCH_SPRITE,
+    BENCH_TEXT,
+    BENCH_COUNT
+};
+
+// [bench][0] = setPixel, [bench][1] = batched
+volatile uint32_t bench_cycles[BENCH_COUNT][2];
+
+// 5x3 sprite, 3 bytes per row, color 0 = transparent
+const uint8_t sprite[3 * 3] = {
+    0x21, 0x43, 0x05,
+    0x07, 0x00, 0x09,
+    0xBA, 0xDC, 0x0E
+};
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Helpers                                            |
+// ------------------------------------------------------------------------------------------------
+// compare rows of the left half with the right half
+int compareHalves(int row, int height) {
+    for (int y = row; y < row + height; y++) {
+        for (int x = 0; x < REFERENCE_OFFSET / 8; x++) {
+            int word = y * (VGA_SCREEN_WIDTH / 8) + x;
+            if (VGA_START_WORD_ADDRESS[word] != VGA_START_WORD_ADDRESS[word + REFERENCE_OFFSET / 8]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    // Initial test (intentionally fails)
+    check(0);
+
+    uint32_t start;
+
+    // clear the test area
+    fillRect(0, 0, VGA_SCREEN_WIDTH, 16, VGA_COLOR_BLACK);
+    check(compareHalves(0, 16));
+
+    // rectangle with unaligned head and tail
+    start = readCycles();
+    for (int y = 1; y < 4; y++) {
+        for (int x = 3; x < 3 + 29; x++) {
+            setPixel(rowCol2pxIdx(y, x + REFERENCE_OFFSET), VGA_COLOR_RED);
+        }
+    }
+    bench_cycles[BENCH_RECT][0] = readCycles() - start;
+    start = readCycles();
+    fillRect(1, 3, 29, 3, VGA_COLOR_RED);
+    bench_cycles[BENCH_RECT][1] = readCycles() - start;
+    check(compareHalves(0, 5));
+
+    // span within a single word
+    fillSpan(4, 9, 3, VGA_COLOR_GREEN);
+    for (int x = 9; x < 12; x++) {
+        setPixel(rowCol2pxIdx(4, x + REFERENCE_OFFSET), VGA_COLOR_GREEN);
+    }
+    check(compareHalves(4, 1));
+
+    // sprite with transparency on top of the rectangle
+    start = readCycles();
+    for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 5; x++) {
+            uint8_t data = sprite[y * 3 + (x >> 1)];
+            uint8_t color = (x & 1) ? (data >> 4) : (data & 0xF);
+            if (color != 0) {
+                setPixel(rowCol2pxIdx(2 + y, 6 + x + REFERENCE_OFFSET), color);
+            }
+        }
+    }
+    bench_cycles[BENCH_SPRITE][0] = readCycles() - start;
+    start = readCycles();
+    drawSprite(2, 6, sprite, 5, 3, 0);
+    bench_cycles[BENCH_SPRITE][1] = readCycles() - start;
+    check(compareHalves(0, 5));
+
+    // text "1" (glyph 010/110/010/010/111) with background
+    const uint8_t one[FONT_GLYPH_HEIGHT] = { 0b010, 0b110, 0b010, 0b010, 0b111 };
+    start = readCycles();
+    for (int y = 0; y < FONT_CHAR_HEIGHT; y++) {
+        for (int x = 0; x < FONT_CHAR_WIDTH; x++) {
+            int set = y < FONT_GLYPH_HEIGHT && x < FONT_GLYPH_WIDTH && ((one[y] >> (2 - x)) & 1);
+            setPixel(rowCol2pxIdx(8 + y, 13 + x + REFERENCE_OFFSET), set ? VGA_COLOR_WHITE : VGA_COLOR_BLUE);
+        }
+    }
+    bench_cycles[BENCH_TEXT][0] = readCycles() - start;
+    start = readCycles();
+    drawText(8, 13, "1", VGA_COLOR_WHITE, VGA_COLOR_BLUE);
+    bench_cycles[BENCH_TEXT][1] = readCycles() - start;
+    check(compareHalves(8, FONT_CHAR_HEIGHT));
+
+    // clipping (nothing may be written outside of the screen)
+    fillRect(-5, -5, 10, 10, VGA_COLOR_YELLOW);
+    check(VGA_START_WORD_ADDRESS[0] == 0x000EEEEE);
+    check((VGA_START_WORD_ADDRESS[4 * (VGA_SCREEN_WIDTH / 8)] & 0xFF) == 0xEE);
+
+    // batched drawing is faster
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        check(bench_cycles[i][1] < bench_cycles[i][0]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: lockfree.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Test of the lock-free queue and event counter (lockfree.h).                                  |
+// |                                                                                              |
+// | The interrupt of the test peripheral is re-armed by the handler every DELAY cycles. On every |
+// | interrupt the handler produces the next byte into to_main, consumes one byte of to_isr and   |
+// | signals an event, while main concurrently consumes to_main and produces into to_isr with     |
+// | interrupts enabled. Both byte streams must arrive complete and in order.                     |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "peripherals.h"
+#include "helperfunctions.h"
+#include "lockfree.h"
+#include "test.h"
+
+#define COUNT 200
+#define DELAY 200
+
+QUEUE_DEFINE(to_main, 8);
+QUEUE_DEFINE(to_isr, 8);
+event_t interrupts;
+
+volatile uint32_t produced = 0;
+volatile uint32_t received = 0;
+volatile uint8_t  received_bytes[COUNT];
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Helpers                                            |
+// ------------------------------------------------------------------------------------------------
+uint32_t interruptsEnabled() {
+    uint32_t mstatus;
+    asm volatile("csrr %0, mstatus" : "=r"(mstatus));
+    return mstatus & (1<<3);
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                          Interrupt                                           |
+// ------------------------------------------------------------------------------------------------
+__attribute__((interrupt))
+void interrupt() {
+    // producer of to_main (retried on the next interrupt if full)
+    if (produced < COUNT && queuePush(&to_main, (uint8_t) produced)) {
+        produced = produced + 1;
+    }
+    // consumer of to_isr
+    uint8_t value;
+    if (received < COUNT && queuePop(&to_isr, &value)) {
+        received_bytes[received] = value;
+        received = received + 1;
+    }
+    eventSignal(&interrupts);
+    // re-arm or stop
+    *TEST_INTERRUPT_ADDRESS = (produced < COUNT || received < COUNT) ? DELAY : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    // Initial test (intentionally fails)
+    check(0);
+
+    // queue without interrupts: empty, full, wrap around
+    uint8_t value;
+    check(queueCount(&to_main) == 0 && !queuePop(&to_main, &value));
+    for (int i = 0; i < 8; i++) {
+        check(queuePush(&to_main, 0xA0 + i));
+    }
+    check(!queuePush(&to_main, 0xFF) && queueCount(&to_main) == 8);
+    for (int i = 0; i < 8; i++) {
+        check(queuePop(&to_main, &value) && value == 0xA0 + i);
+    }
+    check(!queuePop(&to_main, &value));
+
+    // critical section (nested)
+    check(!interruptsEnabled());
+    enableDisable_machineInterrupts(1);
+    check(interruptsEnabled());
+    uint32_t outer = interruptsSave();
+    check(!interruptsEnabled());
+    uint32_t inner = interruptsSave();
+    interruptsRestore(inner);
+    check(!interruptsEnabled());
+    interruptsRestore(outer);
+    check(interruptsEnabled());
+    enableDisable_machineInterrupts(0);
+
+    // concurrent producer/consumer
+    asm("csrw mtvec, %0": : "r"(interrupt));
+    enableDisable_externalInterrupts(1);
+    enableDisable_machineInterrupts(1);
+    *TEST_INTERRUPT_ADDRESS = DELAY;
+
+    uint32_t consumed = 0;
+    uint32_t sent = 0;
+    uint32_t events = 0;
+    int in_order = 1;
+    while (consumed < COUNT || received < COUNT) {
+        if (queuePop(&to_main, &value)) {
+            in_order &= (value == (uint8_t) consumed);
+            consumed++;
+        }
+        if (sent < COUNT && queuePush(&to_isr, (uint8_t) (sent ^ 0x55))) {
+            sent++;
+        }
+        events += eventTake(&interrupts);
+    }
+    enableDisable_machineInterrupts(0);
+    events += eventTake(&interrupts);
+
+    check(in_order);
+    check(consumed == COUNT && produced == COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        check(received_bytes[i] == (uint8_t) (i ^ 0x55));
+    }
+    // every interrupt was counted exactly once
+    check(events == interrupts.signaled && events >= COUNT);
+    check(eventTake(&interrupts) == 0);
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: multicore.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Test of the multi-core mcu (multicore.h, wishbone_mailbox.sv, wishbone_arbiter.sv).          |
+// |                                                                                              |
+// | make test/c/multicore: mailbox registers and inter-processor interrupt on hart 0 only.       |
+// |                                                                                              |
+// | make clean test/c/multicore NUM_CORES=n: additionally, hart 0 hands out jobs (seed in the    |
+// | message register of a hart, cleared by the hart when the result is written) to the other     |
+// | harts. The same jobs run once one after another on hart 1 and once spread over all harts,    |
+// | the cycles of both runs are reported. The jobs only use the local memory and the TCM, so the |
+// | parallel run has to scale (almost) linearly with the number of harts.                        |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "peripherals.h"
+#include "helperfunctions.h"
+#include "multicore.h"
+#include "bench.h"
+#include "tcm.h"
+#include "test.h"
+
+#define ROUNDS     2
+#define ITERATIONS 64
+
+volatile uint32_t results[8];
+volatile uint32_t jobs[8];
+volatile uint32_t hart_ids[8];
+volatile uint32_t ipi_count = 0;
+
+// jobs done by this hart (every hart has its own TCM)
+__tcm_bss uint32_t jobs_done;
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Helpers                                            |
+// ------------------------------------------------------------------------------------------------
+// xorshift sequence of a seed (no multiplication, nothing outside of the function is called)
+#define DEFINE_WORK(name, placement)                     \
+    placement uint32_t name(uint32_t seed) {             \
+        uint32_t x = seed;                               \
+        uint32_t sum = 0;                                \
+        for (int i = 0; i < ITERATIONS; i++) {           \
+            x ^= x << 13;                                \
+            x ^= x >> 17;                                \
+            x ^= x << 5;                                 \
+            sum += x;                                    \
+        }                                                \
+        return sum;                                      \
+    }
+
+DEFINE_WORK(work, __local)
+DEFINE_WORK(reference, )
+
+uint32_t seed(uint32_t round, uint32_t hart) {
+    return 0x1000 + (round << 4) + hart;
+}
+
+void dispatch(uint32_t hart, uint32_t job_seed) {
+    *MAILBOX_MESSAGE_ADDRESS(hart) = job_seed;
+}
+
+void waitIdle(uint32_t hart) {
+    while (*MAILBOX_MESSAGE_ADDRESS(hart) != 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                            Harts                                             |
+// ------------------------------------------------------------------------------------------------
+__local
+void hart_main(uint32_t hart) {
+    hart_ids[hart] = *MAILBOX_HARTID_ADDRESS;
+    jobs_done = 0;
+    while (1) {
+        uint32_t job_seed = *MAILBOX_MESSAGE_ADDRESS(hart);
+        if (job_seed != 0) {
+            results[hart] = work(job_seed);
+            jobs_done = jobs_done + 1;
+            jobs[hart] = jobs_done;
+            // done (the result is written before)
+            *MAILBOX_MESSAGE_ADDRESS(hart) = 0;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                          Interrupt                                           |
+// ------------------------------------------------------------------------------------------------
+__attribute__((interrupt))
+void interrupt() {
+    ipi_count = ipi_count + 1;
+    ipiClear(0);
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    // Initial test (intentionally fails)
+    check(0);
+
+    uint32_t harts = numHarts();
+    check(harts >= 1 && harts <= 8);
+    check(hartId() == 0);
+
+    // all harts were started by __start (hart_main is defined)
+    check(hartsRunning() == (1u << harts) - 1);
+
+    // message register of hart 0 (not used by the jobs): words and bytes
+    *MAILBOX_MESSAGE_ADDRESS(0) = 0x12345678;
+    check(*MAILBOX_MESSAGE_ADDRESS(0) == 0x12345678);
+    ((volatile uint8_t *) MAILBOX_MESSAGE_ADDRESS(0))[1] = 0xAB;
+    check(*MAILBOX_MESSAGE_ADDRESS(0) == 0x1234AB78);
+    *MAILBOX_MESSAGE_ADDRESS(0) = 0;
+
+    // inter-processor interrupt to this hart
+    asm("csrw mtvec, %0": : "r"(interrupt));
+    check(ipiPending() == 0);
+    ipiSend(0);
+    check(ipiPending() == 1);
+    enableDisable_externalInterrupts(1);
+    enableDisable_machineInterrupts(1);
+    for (int i = 0; i < 10 && ipi_count == 0; i++);
+    enableDisable_machineInterrupts(0);
+    check(ipi_count == 1);
+    check(ipiPending() == 0);
+
+    // hart 0 can't be stopped
+    hartsStop(1);
+    check(hartsRunning() & 1);
+
+    if (harts == 1) {
+        return 0;
+    }
+
+    // the other harts identified themselves
+    for (uint32_t hart = 1; hart < harts; hart++) {
+        while (hart_ids[hart] != hart);
+        check(hart_ids[hart] == hart);
+    }
+
+    // expected results (outside of the measurements)
+    uint32_t expected[ROUNDS][8];
+    uint32_t serial[ROUNDS][8];
+    uint32_t parallel[ROUNDS][8];
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        for (uint32_t hart = 1; hart < harts; hart++) {
+            expected[round][hart] = reference(seed(round, hart));
+        }
+    }
+
+    // the same jobs on hart 1 only
+    uint32_t start = readCycles();
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        for (uint32_t hart = 1; hart < harts; hart++) {
+            dispatch(1, seed(round, hart));
+            waitIdle(1);
+            serial[round][hart] = results[1];
+        }
+    }
+    uint32_t serial_cycles = readCycles() - start;
+    check(jobs[1] == ROUNDS * (harts - 1));
+
+    // spread over all harts
+    start = readCycles();
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        for (uint32_t hart = 1; hart < harts; hart++) {
+            dispatch(hart, seed(round, hart));
+        }
+        for (uint32_t hart = 1; hart < harts; hart++) {
+            waitIdle(hart);
+            parallel[round][hart] = results[hart];
+        }
+    }
+    uint32_t parallel_cycles = readCycles() - start;
+
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        for (uint32_t hart = 1; hart < harts; hart++) {
+            check(serial[round][hart] == expected[round][hart]);
+            check(parallel[round][hart] == expected[round][hart]);
+        }
+    }
+
+    // every hart counted its own jobs in its TCM
+    check(jobs[1] == ROUNDS * harts);
+    for (uint32_t hart = 2; hart < harts; hart++) {
+        check(jobs[hart] == ROUNDS);
+    }
+
+    // (almost) linear: at most 25 % above serial / (harts - 1)
+    check(parallel_cycles * (harts - 1) <= serial_cycles + serial_cycles / 4);
+
+    benchReport("ser", serial_cycles);
+    benchReport("par", parallel_cycles);
+
+    // stop the other harts
+    hartsStop(~1u);
+    check(hartsRunning() == 1);
+
+    return 0;
+}
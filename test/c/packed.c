@@ -0,0 +1,229 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: packed.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Self-check and cycle-count benchmark of the packed nibble/byte operations (packed.h).        |
+// |                                                                                              |
+// | Every operation is compared lane by lane against a scalar reference for pseudo random        |
+// | words. Three kernels (solid color fill, transparent blit, byte brighten/clamp) are run with  |
+// | scalar code and with packed operations, the cycles are stored in "bench_cycles"              |
+// | (reference, packed) and sent over the UART.                                                  |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "peripherals.h"
+#include "packed.h"
+#include "uart.h"
+#include "test.h"
+
+#define ITERATIONS  200
+#define BUFFER_SIZE 64 // words
+
+enum Bench {
+    BENCH_FILL,
+    BENCH_BLIT,
+    BENCH_BRIGHTEN,
+    BENCH_COUNT
+};
+
+const char *bench_names[BENCH_COUNT] = { "fill", "blit", "brighten" };
+
+// [bench][0] = reference, [bench][1] = packed
+volatile uint32_t bench_cycles[BENCH_COUNT][2];
+
+uint32_t source[BUFFER_SIZE];
+uint32_t dest[BUFFER_SIZE];
+uint32_t expected[BUFFER_SIZE];
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Helpers                                            |
+// ------------------------------------------------------------------------------------------------
+uint32_t random_state = 0x12345678;
+
+// xorshift32
+uint32_t nextRandom() {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+int equal(const uint32_t *a, const uint32_t *b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (a[i] != b[i]) return 0;
+    }
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                    Reference implementations                                 |
+// ------------------------------------------------------------------------------------------------
+uint32_t lane(uint32_t word, int index, int bits) {
+    return (word >> (index * bits)) & ((1u << bits) - 1);
+}
+
+uint32_t referenceNibbleEqualMask(uint32_t a, uint32_t b) {
+    uint32_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        if (lane(a, i, 4) == lane(b, i, 4)) mask |= 0xFu << (i * 4);
+    }
+    return mask;
+}
+
+// operation: 0 add, 1 sub, 2 add saturate, 3 sub saturate, 4 less, 5 equal, 6 min, 7 max
+uint32_t referenceByte(uint32_t a, uint32_t b, int operation) {
+    uint32_t result = 0;
+    for (int i = 0; i < 4; i++) {
+        uint32_t x = lane(a, i, 8);
+        uint32_t y = lane(b, i, 8);
+        uint32_t r;
+        switch (operation) {
+            case 0:  r = x + y; break;
+            case 1:  r = x - y; break;
+            case 2:  r = (x + y > 0xFF) ? 0xFF : x + y; break;
+            case 3:  r = (x < y) ? 0 : x - y; break;
+            case 4:  r = (x < y) ? 0xFF : 0; break;
+            case 5:  r = (x == y) ? 0xFF : 0; break;
+            case 6:  r = (x < y) ? x : y; break;
+            default: r = (x < y) ? y : x; break;
+        }
+        result |= (r & 0xFF) << (i * 8);
+    }
+    return result;
+}
+
+uint32_t packedByte(uint32_t a, uint32_t b, int operation) {
+    switch (operation) {
+        case 0:  return byteAdd(a, b);
+        case 1:  return byteSub(a, b);
+        case 2:  return byteAddSaturate(a, b);
+        case 3:  return byteSubSaturate(a, b);
+        case 4:  return byteLessMask(a, b);
+        case 5:  return byteEqualMask(a, b);
+        case 6:  return byteMin(a, b);
+        default: return byteMax(a, b);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    // Initial test (intentionally fails)
+    check(0);
+
+    uint32_t start;
+
+    // nibble operations
+    for (uint32_t color = 0; color < 16; color++) {
+        uint32_t word = 0;
+        for (int pixel = 0; pixel < 8; pixel++) word |= color << (pixel * 4);
+        check(nibbleBroadcast(color) == word);
+        check(nibbleBroadcast(color | 0xF0) == word);
+    }
+    for (int i = 0; i < ITERATIONS; i++) {
+        uint32_t a = nextRandom();
+        // make some lanes equal
+        uint32_t b = (i & 1) ? (nextRandom() & 0xF0F0FF00) | (a & 0x0F0F00FF) : nextRandom();
+        int index = i & 0b111;
+        check(nibbleExtract(a, index) == lane(a, index, 4));
+        check(nibbleInsert(a, index, b) == ((a & ~(0xFu << (index * 4))) | ((b & 0xF) << (index * 4))));
+        check(nibbleEqualMask(a, b) == referenceNibbleEqualMask(a, b));
+        check(nibbleSelect(0x0F0F00FF, a, b) == ((a & 0x0F0F00FF) | (b & 0xF0F0FF00)));
+    }
+
+    // byte operations (second operand partly equal to the first one)
+    for (int i = 0; i < ITERATIONS; i++) {
+        uint32_t a = nextRandom();
+        uint32_t b = (i & 1) ? (nextRandom() & 0xFF00FF00) | (a & 0x00FF00FF) : nextRandom();
+        for (int operation = 0; operation < 8; operation++) {
+            check(packedByte(a, b, operation) == referenceByte(a, b, operation));
+        }
+    }
+    check(byteAddSaturate(0xFF80017F, 0x01800101) == 0xFFFF0280);
+    check(byteSubSaturate(0x00800102, 0x01810101) == 0x00000001);
+
+    // fill: solid color word
+    uint32_t reference_sum = 0, sum = 0;
+    start = readCycles();
+    for (uint32_t color = 0; color < 16; color++) {
+        uint32_t word = 0;
+        for (int pixel = 0; pixel < 8; pixel++) {
+            word |= color << (pixel * 4);
+        }
+        reference_sum += word;
+    }
+    bench_cycles[BENCH_FILL][0] = readCycles() - start;
+    start = readCycles();
+    for (uint32_t color = 0; color < 16; color++) {
+        sum += nibbleBroadcast(color);
+    }
+    bench_cycles[BENCH_FILL][1] = readCycles() - start;
+    check(sum == reference_sum);
+
+    // blit: 4 bit pixels with transparent color 0
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        source[i] = nextRandom() & ((i & 1) ? 0xF0F00FFF : 0xFFFFFFFF);
+        dest[i] = expected[i] = nextRandom();
+    }
+    start = readCycles();
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        for (int pixel = 0; pixel < 8; pixel++) {
+            uint32_t color = nibbleExtract(source[i], pixel);
+            if (color != 0) {
+                expected[i] = nibbleInsert(expected[i], pixel, color);
+            }
+        }
+    }
+    bench_cycles[BENCH_BLIT][0] = readCycles() - start;
+    start = readCycles();
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        dest[i] = nibbleBlend(dest[i], source[i], 0);
+    }
+    bench_cycles[BENCH_BLIT][1] = readCycles() - start;
+    check(equal(dest, expected, BUFFER_SIZE));
+
+    // brighten: bytes + 0x30, clamped to 0x20...0xE0
+    const uint32_t offset = byteBroadcast(0x30);
+    const uint32_t low    = byteBroadcast(0x20);
+    const uint32_t high   = byteBroadcast(0xE0);
+    start = readCycles();
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        uint32_t word = 0;
+        for (int b = 0; b < 4; b++) {
+            uint32_t value = lane(source[i], b, 8) + 0x30;
+            if (value > 0xE0) value = 0xE0;
+            if (value < 0x20) value = 0x20;
+            word |= value << (b * 8);
+        }
+        expected[i] = word;
+    }
+    bench_cycles[BENCH_BRIGHTEN][0] = readCycles() - start;
+    start = readCycles();
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        dest[i] = byteMax(byteMin(byteAddSaturate(source[i], offset), high), low);
+    }
+    bench_cycles[BENCH_BRIGHTEN][1] = readCycles() - start;
+    check(equal(dest, expected, BUFFER_SIZE));
+
+    // every packed kernel must be faster than its reference
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        check(bench_cycles[i][1] < bench_cycles[i][0]);
+    }
+
+    // report
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        uartPrintf("%-14s %6u %6u\n", bench_names[i], bench_cycles[i][0], bench_cycles[i][1]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: std_runtime.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Self-check and cycle-count benchmark of the std runtime.                                     |
+// |                                                                                              |
+// | Every function is compared against a naive reference implementation (byte loops, repeated    |
+// | subtraction), compiled with the same optimization as the std library (-O2). Results are      |
+// | checked via the test peripheral, the measured cycles are stored in "bench_cycles"            |
+// | (reference, std) and sent over the UART.                                                     |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <string.h>
+
+#include "peripherals.h"
+#include "helperfunctions.h"
+#include "uart.h"
+#include "test.h"
+
+#define BUFFER_SIZE 256
+
+enum Bench {
+    BENCH_MEMCPY,
+    BENCH_MEMSET,
+    BENCH_MEMMOVE,
+    BENCH_NUMBER2SEGMENT,
+    BENCH_COUNT
+};
+
+const char *bench_names[BENCH_COUNT] = { "memcpy", "memset", "memmove", "number2segment" };
+
+// [bench][0] = reference, [bench][1] = std
+volatile uint32_t bench_cycles[BENCH_COUNT][2];
+
+uint8_t source[BUFFER_SIZE + 8];
+uint8_t dest[BUFFER_SIZE + 8];
+uint8_t expected[BUFFER_SIZE + 8];
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Helpers                                            |
+// ------------------------------------------------------------------------------------------------
+int equal(const uint8_t *a, const uint8_t *b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (a[i] != b[i]) return 0;
+    }
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                    Reference implementations                                 |
+// ------------------------------------------------------------------------------------------------
+
+// The references are compiled like the std library (C_LIB_FLAGS = -O2) while the test itself is
+// compiled without optimization, gcc must not replace their loops with calls of the std functions.
+#define REFERENCE __attribute__((optimize("O2", "no-tree-loop-distribute-patterns"), noinline))
+
+REFERENCE
+void referenceMemcpy(uint8_t *d, const uint8_t *s, int n) {
+    for (int i = 0; i < n; i++) d[i] = s[i];
+}
+
+REFERENCE
+void referenceMemset(uint8_t *d, uint8_t c, int n) {
+    for (int i = 0; i < n; i++) d[i] = c;
+}
+
+REFERENCE
+void referenceMemmove(uint8_t *d, const uint8_t *s, int n) {
+    if (d < s) { for (int i = 0;     i <  n; i++) d[i] = s[i]; }
+    else       { for (int i = n - 1; i >= 0; i--) d[i] = s[i]; }
+}
+
+REFERENCE
+uint32_t referenceDigit2segment(uint32_t digit) {
+    switch (digit) {
+        case  0: return 0b00111111;
+        case  1: return 0b00000110;
+        case  2: return 0b01011011;
+        case  3: return 0b01001111;
+        case  4: return 0b01100110;
+        case  5: return 0b01101101;
+        case  6: return 0b01111101;
+        case  7: return 0b00000111;
+        case  8: return 0b01111111;
+        case  9: return 0b01101111;
+        default: return 0b00000000;
+    }
+}
+
+REFERENCE
+uint32_t referenceNumber2segment(uint32_t number) {
+    uint32_t segment = 0;
+    while (number > 9999) { number -= 10000; }
+    uint32_t digit = 0;
+    while (number >= 1000) { number -= 1000; digit++; }
+    segment = (segment << 8) | referenceDigit2segment(digit);
+    digit = 0;
+    while (number >= 100) { number -= 100; digit++; }
+    segment = (segment << 8) | referenceDigit2segment(digit);
+    digit = 0;
+    while (number >= 10) { number -= 10; digit++; }
+    segment = (segment << 8) | referenceDigit2segment(digit);
+    segment = (segment << 8) | referenceDigit2segment(number);
+    return segment;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    // Initial test (intentionally fails)
+    check(0);
+
+    uint32_t start;
+
+    for (int i = 0; i < BUFFER_SIZE + 8; i++) {
+        source[i] = i ^ 0x5A;
+    }
+
+    // .bss is cleared by __start
+    check(equal(dest, expected, BUFFER_SIZE + 8));
+
+    // memcpy: aligned (benchmark) and all head/tail alignments
+    start = readCycles();
+    referenceMemcpy(expected, source, BUFFER_SIZE);
+    bench_cycles[BENCH_MEMCPY][0] = readCycles() - start;
+    start = readCycles();
+    memcpy(dest, source, BUFFER_SIZE);
+    bench_cycles[BENCH_MEMCPY][1] = readCycles() - start;
+    check(equal(dest, expected, BUFFER_SIZE));
+
+    for (int offset = 0; offset < 4; offset++) {
+        memset(dest, 0, BUFFER_SIZE + 8);
+        memset(expected, 0, BUFFER_SIZE + 8);
+        referenceMemcpy(expected + offset, source + 1, 37);
+        memcpy(dest + offset, source + 1, 37);
+        check(equal(dest, expected, BUFFER_SIZE + 8));
+    }
+
+    // memset
+    start = readCycles();
+    referenceMemset(expected, 0xA5, BUFFER_SIZE);
+    bench_cycles[BENCH_MEMSET][0] = readCycles() - start;
+    start = readCycles();
+    memset(dest, 0xA5, BUFFER_SIZE);
+    bench_cycles[BENCH_MEMSET][1] = readCycles() - start;
+    check(equal(dest, expected, BUFFER_SIZE));
+
+    referenceMemset(expected + 3, 0x3C, 29);
+    memset(dest + 3, 0x3C, 29);
+    check(equal(dest, expected, BUFFER_SIZE + 8));
+
+    // memmove: overlapping forward and backward
+    referenceMemcpy(expected, source, BUFFER_SIZE + 8);
+    memcpy(dest, source, BUFFER_SIZE + 8);
+    start = readCycles();
+    referenceMemmove(expected + 4, expected, BUFFER_SIZE);
+    bench_cycles[BENCH_MEMMOVE][0] = readCycles() - start;
+    start = readCycles();
+    memmove(dest + 4, dest, BUFFER_SIZE);
+    bench_cycles[BENCH_MEMMOVE][1] = readCycles() - start;
+    check(equal(dest, expected, BUFFER_SIZE + 8));
+
+    referenceMemmove(expected, expected + 5, 100);
+    memmove(dest, dest + 5, 100);
+    check(equal(dest, expected, BUFFER_SIZE + 8));
+
+    // number2segment / digit2segment
+    const uint32_t numbers[] = { 0, 7, 42, 999, 1000, 4711, 9999, 10000, 123456 };
+    const int count = sizeof(numbers) / sizeof(numbers[0]);
+    uint32_t reference_sum = 0, sum = 0;
+    start = readCycles();
+    for (int i = 0; i < count; i++) reference_sum += referenceNumber2segment(numbers[i]);
+    bench_cycles[BENCH_NUMBER2SEGMENT][0] = readCycles() - start;
+    start = readCycles();
+    for (int i = 0; i < count; i++) sum += number2segment(numbers[i]);
+    bench_cycles[BENCH_NUMBER2SEGMENT][1] = readCycles() - start;
+    check(sum == reference_sum);
+    for (int i = 0; i < count; i++) {
+        check(number2segment(numbers[i]) == referenceNumber2segment(numbers[i]));
+    }
+    for (uint32_t digit = 0; digit < 17; digit++) {
+        check(digit2segment(digit) == referenceDigit2segment(digit));
+    }
+
+    // number formatting
+    char buffer[NUMBER_STRING_SIZE];
+    check(uint2str(0, buffer, 10) == 1 && buffer[0] == '0' && buffer[1] == '\0');
+    check(uint2str(4294967295u, buffer, 10) == 10 && equal((uint8_t *) buffer, (uint8_t *) "4294967295", 11));
+    check(int2str(-2147483647 - 1, buffer) == 11 && equal((uint8_t *) buffer, (uint8_t *) "-2147483648", 12));
+    check(uint2str(0xCAFE01, buffer, 16) == 6 && equal((uint8_t *) buffer, (uint8_t *) "cafe01", 7));
+
+    // every std function must be faster than its reference
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        check(bench_cycles[i][1] < bench_cycles[i][0]);
+    }
+
+    // report
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        uartPrintf("%-14s %6u %6u\n", bench_names[i], bench_cycles[i][0], bench_cycles[i][1]);
+    }
+
+    return 0;
+}
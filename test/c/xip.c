@@ -0,0 +1,120 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: xip.c
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Test of the execute-in-place flash window (wishbone_flash.sv, hades-v.ld.in with XIP).       |
+// |                                                                                              |
+// | make xip/test/c/xip: the bootloader finds the image header in the flash model and jumps to   |
+// | __reset in the flash. Code and read only data are read through the line cache, initialized   |
+// | data is copied to RAM by __start. The second run of a loop has to be faster than the first   |
+// | one (all lines cached), the cycles of both runs are reported.                                |
+// |                                                                                              |
+// | make test/c/xip: the same program runs from RAM, the flash window reads as erased.           |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include "peripherals.h"
+#include "bench.h"
+#include "test.h"
+
+#define COUNT 64
+
+const uint32_t table[COUNT] = {
+    0x00000001, 0x00000002, 0x00000004, 0x00000008, 0x00000010, 0x00000020, 0x00000040, 0x00000080,
+    0x00000100, 0x00000200, 0x00000400, 0x00000800, 0x00001000, 0x00002000, 0x00004000, 0x00008000,
+    0x00010000, 0x00020000, 0x00040000, 0x00080000, 0x00100000, 0x00200000, 0x00400000, 0x00800000,
+    0x01000000, 0x02000000, 0x04000000, 0x08000000, 0x10000000, 0x20000000, 0x40000000, 0x80000000,
+    0xFFFFFFFE, 0xFFFFFFFD, 0xFFFFFFFB, 0xFFFFFFF7, 0xFFFFFFEF, 0xFFFFFFDF, 0xFFFFFFBF, 0xFFFFFF7F,
+    0xFFFFFEFF, 0xFFFFFDFF, 0xFFFFFBFF, 0xFFFFF7FF, 0xFFFFEFFF, 0xFFFFDFFF, 0xFFFFBFFF, 0xFFFF7FFF,
+    0xFFFEFFFF, 0xFFFDFFFF, 0xFFFBFFFF, 0xFFF7FFFF, 0xFFEFFFFF, 0xFFDFFFFF, 0xFFBFFFFF, 0xFF7FFFFF,
+    0xFEFFFFFF, 0xFDFFFFFF, 0xFBFFFFFF, 0xF7FFFFFF, 0xEFFFFFFF, 0xDFFFFFFF, 0xBFFFFFFF, 0x7FFFFFFF
+};
+
+const char message[] = "execute in place";
+
+uint32_t initialized = 0x12345678;
+uint8_t  initialized_bytes[4] = { 0xA5, 0x5A, 0x3C, 0xC3 };
+
+// ------------------------------------------------------------------------------------------------
+// |                                           Helpers                                            |
+// ------------------------------------------------------------------------------------------------
+int inFlash(const void *address) {
+    return (uint32_t) address - (uint32_t) FLASH_ADDRESS < FLASH_SIZE;
+}
+
+// xor of the table, rotated per element
+uint32_t checksum() {
+    uint32_t sum = 0;
+    for (int i = 0; i < COUNT; i++) {
+        sum = ((sum << 1) | (sum >> 31)) ^ table[i];
+    }
+    return sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+// |                                             Main                                             |
+// ------------------------------------------------------------------------------------------------
+int main() {
+    // Initial test (intentionally fails)
+    check(0);
+
+    int xip = inFlash(main);
+
+    // image header (written by the linker) or erased flash
+    if (xip) {
+        check(FLASH_ADDRESS[FLASH_IMAGE_IDX_MAGIC] == FLASH_IMAGE_MAGIC);
+        check(inFlash((void *) FLASH_ADDRESS[FLASH_IMAGE_IDX_ENTRY]));
+        check(inFlash(table) && inFlash(message));
+    }
+    else {
+        check(FLASH_ADDRESS[FLASH_IMAGE_IDX_MAGIC] == 0xFFFFFFFF);
+        check(FLASH_ADDRESS[FLASH_SIZE / 4 - 1] == 0xFFFFFFFF);
+    }
+
+    // writable data is never in the flash
+    check(!inFlash(&initialized) && !inFlash(initialized_bytes));
+    check(initialized == 0x12345678);
+    check(initialized_bytes[0] == 0xA5 && initialized_bytes[1] == 0x5A);
+    check(initialized_bytes[2] == 0x3C && initialized_bytes[3] == 0xC3);
+    initialized = 0;
+    check(initialized == 0);
+
+    // read only data: words, bytes (every byte lane of a cached word) and halfwords
+    for (int i = 0; i < 32; i++) {
+        check(table[i] == 1u << i);
+        check(table[i + 32] == ~(1u << i));
+    }
+    const char *expected = "execute in place";
+    for (int i = 0; expected[i] != 0; i++) {
+        check(message[i] == expected[i]);
+    }
+    check(((const uint16_t *) table)[63 * 2 + 1] == 0x7FFF);
+
+    // cold and warm run of the same loop
+    uint32_t start = readCycles();
+    uint32_t cold = checksum();
+    uint32_t cold_cycles = readCycles() - start;
+
+    start = readCycles();
+    uint32_t warm = checksum();
+    uint32_t warm_cycles = readCycles() - start;
+
+    check(cold == warm);
+    if (xip) {
+        check(warm_cycles < cold_cycles);
+    }
+
+    benchReport("cold", cold_cycles);
+    benchReport("warm", warm_cycles);
+
+    return 0;
+}
@@ -0,0 +1,245 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: fuzz.py
+#
+# Differential fuzzing campaign: random programs (generator.py) run on the simulated MCU and on
+# the instruction set reference (iss.py), the final architectural state (registers x1..x29,
+# mscratch, mie, mstatus.MIE/MPIE, data buffer) reported by the programs must match.
+#
+# Programs are built and simulated in parallel, each in build/test/fuzz/<seed>/. A failing
+# program is shrunk by removing blocks as long as it keeps failing; the original and the
+# minimal program and the differences are kept in build/test/fuzz/failures/<seed>/.
+#
+# Usage (see "make fuzz"):
+#   fuzz.py --sim TOP --cc GCC --objcopy OBJCOPY --linker-script LD [--programs N] [--seed S]
+#           [--length BLOCKS] [--jobs N] [--timeout CYCLES] [--no-shrink]
+#   fuzz.py --sim TOP ... --replay program.s
+
+import argparse
+import copy
+import multiprocessing
+import os
+import shutil
+import subprocess
+import sys
+
+import generator
+import iss
+
+
+class Tools:
+    def __init__(self, args):
+        self.sim = os.path.abspath(args.sim)
+        self.cc = args.cc
+        self.objcopy = args.objcopy
+        self.linker_script = os.path.abspath(args.linker_script)
+        self.memory_size_kb = args.memory_size_kb
+        self.timeout = args.timeout
+
+
+# ------------------------------------------------------------------------------------------------
+# Single program
+
+def build(tools, source, directory):
+    """Assembles the program like the asm tests, returns the content of init.bin."""
+    os.makedirs(directory, exist_ok=True)
+    with open(os.path.join(directory, "program.s"), "w") as source_file:
+        source_file.write(source)
+    commands = [
+        [tools.cc, "-nostdlib", "-nostartfiles", "-T", tools.linker_script, "-o", "init.elf", "program.s"],
+        [tools.objcopy, "-O", "binary", "init.elf", "init.bin"],
+        [tools.objcopy, "-I", "binary", "-O", "verilog", "--verilog-data-width", "4", "--reverse-bytes=4",
+         "init.bin", "init.mem"],
+    ]
+    for command in commands:
+        result = subprocess.run(command, cwd=directory, capture_output=True, text=True)
+        if result.returncode != 0:
+            raise RuntimeError(f"{' '.join(command)} failed:\n{result.stderr}")
+    with open(os.path.join(directory, "init.bin"), "rb") as image_file:
+        return image_file.read()
+
+
+def simulate(tools, directory):
+    """Returns (finished, reports) of the simulation."""
+    result = subprocess.run([tools.sim, "+notrace", f"+timeout={tools.timeout}"], cwd=directory,
+                            capture_output=True, text=True)
+    with open(os.path.join(directory, "sim.log"), "w") as log_file:
+        log_file.write(result.stdout)
+    reports = {}
+    for line in result.stdout.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0] == "REPORT":
+            reports[fields[1]] = int(fields[2])
+    finished = "Simulation timeout!" not in result.stdout and result.returncode == 0
+    return finished, reports
+
+
+def compare(expected, actual):
+    """Differences between the reference and the simulation (empty if equal)."""
+    differences = []
+    for key, value in expected.items():
+        if key not in actual:
+            differences.append(f"{key:<5} reference 0x{value:08x}, simulation missing")
+        elif actual[key] != value:
+            differences.append(f"{key:<5} reference 0x{value:08x}, simulation 0x{actual[key]:08x}")
+    return differences
+
+
+def check(tools, source, directory):
+    """Runs one program on both sides, returns the list of differences (None: invalid program)."""
+    image = build(tools, source, directory)
+    halted, expected = iss.run(image, tools.memory_size_kb)
+    if not halted:
+        return None
+    finished, actual = simulate(tools, directory)
+    differences = compare(expected, actual)
+    if not finished:
+        differences.insert(0, "simulation did not finish (timeout)")
+    return differences
+
+
+# ------------------------------------------------------------------------------------------------
+# Shrinking
+
+def block_lists(program):
+    """All lists of blocks in the program (top level and children of containers)."""
+    lists = [program.blocks]
+    pending = list(program.blocks)
+    while pending:
+        block = pending.pop()
+        if block.children:
+            lists.append(block.children)
+            pending += block.children
+    return lists
+
+
+def candidates(program):
+    """Smaller variants: chunks removed from each block list, containers replaced by their children."""
+    for index in range(len(block_lists(program))):
+        size = len(block_lists(program)[index])
+        chunk = size // 2
+        while chunk >= 1:
+            for start in range(0, size, chunk):
+                candidate = copy.deepcopy(program)
+                blocks = block_lists(candidate)[index]
+                del blocks[start:start + chunk]
+                yield candidate
+            chunk //= 2
+        for position in range(size):
+            if block_lists(program)[index][position].children:
+                candidate = copy.deepcopy(program)
+                blocks = block_lists(candidate)[index]
+                blocks[position:position + 1] = blocks[position].children
+                yield candidate
+
+
+def shrink(tools, program, directory, limit):
+    """Removes blocks while the program keeps failing, returns (program, differences)."""
+    differences = check(tools, program.render(), directory)
+    runs = 0
+    progress = True
+    while progress and runs < limit:
+        progress = False
+        for candidate in candidates(program):
+            runs += 1
+            try:
+                result = check(tools, candidate.render(), directory)
+            except RuntimeError:
+                result = None
+            if result:
+                program, differences = candidate, result
+                progress = True
+                break
+            if runs >= limit:
+                break
+    return program, differences
+
+
+# ------------------------------------------------------------------------------------------------
+# Campaign
+
+def run_seed(job):
+    tools, build_dir, seed, length, shrink_limit = job
+    directory = os.path.join(build_dir, str(seed))
+    program = generator.generate(seed, length)
+    try:
+        differences = check(tools, program.render(), directory)
+    except RuntimeError as error:
+        return seed, [str(error)]
+    if differences is None:
+        return seed, ["reference did not halt (generator error)"]
+    if not differences:
+        shutil.rmtree(directory, ignore_errors=True)
+        return seed, []
+
+    failure_dir = os.path.join(build_dir, "failures", str(seed))
+    os.makedirs(failure_dir, exist_ok=True)
+    with open(os.path.join(failure_dir, "original.s"), "w") as source_file:
+        source_file.write(program.render())
+    if shrink_limit > 0:
+        minimal, minimal_differences = shrink(tools, program, directory, shrink_limit)
+        with open(os.path.join(failure_dir, "minimal.s"), "w") as source_file:
+            source_file.write(minimal.render())
+        with open(os.path.join(failure_dir, "differences.txt"), "w") as differences_file:
+            differences_file.write("\n".join(minimal_differences) + "\n")
+        differences = [f"shrunk from {program.count()} to {minimal.count()} blocks"] + minimal_differences
+    shutil.rmtree(directory, ignore_errors=True)
+    return seed, differences
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Differential fuzzing of the HaDes-V pipeline")
+    parser.add_argument("--sim", required=True, help="simulation executable (build/sim/top)")
+    parser.add_argument("--cc", required=True, help="riscv gcc")
+    parser.add_argument("--objcopy", required=True, help="riscv objcopy")
+    parser.add_argument("--linker-script", required=True, help="generated hades-v.ld")
+    parser.add_argument("--memory-size-kb", type=int, default=32)
+    parser.add_argument("--build-dir", default="build/test/fuzz")
+    parser.add_argument("--programs", type=int, default=1000)
+    parser.add_argument("--seed", type=int, default=0, help="seed of the first program")
+    parser.add_argument("--length", type=int, default=200, help="random blocks per program")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count())
+    parser.add_argument("--timeout", type=int, default=200000, help="simulation cycles per program")
+    parser.add_argument("--shrink-limit", type=int, default=500, help="max. simulations per shrink")
+    parser.add_argument("--no-shrink", action="store_true")
+    parser.add_argument("--replay", metavar="FILE", help="run a single (e.g. shrunk) program")
+    args = parser.parse_args()
+
+    tools = Tools(args)
+    build_dir = os.path.abspath(args.build_dir)
+
+    if args.replay:
+        with open(args.replay) as source_file:
+            differences = check(tools, source_file.read(), os.path.join(build_dir, "replay"))
+        if differences is None:
+            print("Reference did not halt")
+            return 1
+        print("\n".join(differences) if differences else "No differences")
+        return 1 if differences else 0
+
+    shrink_limit = 0 if args.no_shrink else args.shrink_limit
+    jobs = [(tools, build_dir, seed, args.length, shrink_limit)
+            for seed in range(args.seed, args.seed + args.programs)]
+    failures = {}
+    with multiprocessing.Pool(args.jobs) as pool:
+        for done, (seed, differences) in enumerate(pool.imap_unordered(run_seed, jobs), 1):
+            if differences:
+                failures[seed] = differences
+                print(f"Seed {seed} failed:")
+                for line in differences[:10]:
+                    print(f"    {line}")
+            if done % 100 == 0 or done == len(jobs):
+                print(f"{done}/{len(jobs)} programs, {len(failures)} failed")
+
+    if failures:
+        print(f"Failing seeds: {' '.join(str(seed) for seed in sorted(failures))}")
+        print(f"Programs and differences: {os.path.join(build_dir, 'failures')}")
+        return 1
+    print("All programs match the reference")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
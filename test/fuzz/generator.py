@@ -0,0 +1,361 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: generator.py
+#
+# Random RV32I + Zicsr program generator for the differential fuzzing (see fuzz.py).
+#
+# A program is a tree of blocks. Leaf blocks are short instruction sequences, branches, jumps
+# and loops contain the blocks they skip or repeat. Removing any block keeps the program valid,
+# which is what the shrinker in fuzz.py relies on.
+#
+# The random blocks are biased towards:
+#   - dependency chains (sources are mostly recently written registers, to hit all forwarding
+#     paths and load-use stalls)
+#   - taken/not taken forward branches, jal/jalr and short loops (flushes)
+#   - aligned and misaligned loads/stores to a data buffer, accesses to the stall and error
+#     registers of the test peripheral (bus stalls, load/store faults)
+#   - ecall, ebreak, illegal instructions and mscratch accesses (traps, CSR hazards)
+#   - external interrupts of the test peripheral arriving at arbitrary points
+#
+# The final state must not depend on timing, so the program follows some rules:
+#   - x25..x31 are reserved (see PROLOGUE), random blocks only use x1..x24
+#   - the trap handler only changes t5/t6, x26 (trap signature: mcause and mepc of every
+#     exception) and x27 (set when an interrupt was taken)
+#   - before the final state is reported, the program waits for the last armed interrupt
+#   - mepc/mcause/mip are not reported (interrupts arrive at different instructions)
+
+import random
+
+# Registers for random blocks and the registers written by the epilogue
+RANDOM_REGISTERS = list(range(1, 25))
+REPORTED_REGISTERS = list(range(1, 30))
+
+# Data buffer (words) addressed via t4
+BUFFER_WORDS = 64
+
+# Test peripheral register offsets (bytes)
+TEST_INTERRUPT = 4
+TEST_STALL = 12
+TEST_ERROR = 16
+TEST_REPORT_KEY = 20
+TEST_REPORT_VALUE = 24
+
+ALU_REG = ["add", "sub", "sll", "slt", "sltu", "xor", "srl", "sra", "or", "and"]
+ALU_IMM = ["addi", "slti", "sltiu", "xori", "ori", "andi"]
+SHIFT_IMM = ["slli", "srli", "srai"]
+BRANCHES = ["beq", "bne", "blt", "bge", "bltu", "bgeu"]
+LOADS = {"lb": 1, "lbu": 1, "lh": 2, "lhu": 2, "lw": 4}
+STORES = {"sb": 1, "sh": 2, "sw": 4}
+CSR_OPS = ["csrrw", "csrrs", "csrrc"]
+CSR_IMM_OPS = ["csrrwi", "csrrsi", "csrrci"]
+
+PROLOGUE = """\
+# Generated by test/fuzz/generator.py (seed {seed})
+#
+# ------------------------------------------------------------------------------------------------
+# |                                                                                              |
+# | Register allocation:                                                                         |
+# |     x1..x24:    random blocks                                                                |
+# |     x25 (s9):   interrupt armed                                                              |
+# |     x26 (s10):  trap signature (mcause and mepc of every exception)                          |
+# |     x27 (s11):  interrupt taken                                                              |
+# |     x28 (t3):   test peripheral address                                                      |
+# |     x29 (t4):   data buffer address                                                          |
+# |     x30 (t5):   trap handler / epilogue temporary                                            |
+# |     x31 (t6):   trap handler / epilogue temporary                                            |
+# |                                                                                              |
+# ------------------------------------------------------------------------------------------------
+
+.global __reset
+__reset:
+    beq  zero, zero, fuzz_init
+
+# exceptions: add mcause and mepc to the signature, continue behind the instruction
+# interrupts: acknowledge, remember and return
+trap_handler:
+    csrr t6, mcause
+    bltz t6, trap_interrupt
+    slli t5, s10, 5
+    add  s10, s10, t5
+    add  s10, s10, t6
+    csrr t6, mepc
+    slli t5, s10, 5
+    add  s10, s10, t5
+    add  s10, s10, t6
+    addi t6, t6, 4
+    csrw mepc, t6
+    mret
+trap_interrupt:
+    sw   zero, {interrupt}(t3)
+    addi s11, zero, 1
+    mret
+
+fuzz_init:
+    lui  t3, %hi(0x120000<<2)
+    addi t3, t3, %lo(0x120000<<2)
+    la   t4, buffer
+    la   t5, trap_handler
+    csrw mtvec, t5
+    li   s9, 0
+    li   s10, 0
+    li   s11, 0
+    nop
+    nop
+    nop
+    nop
+    nop
+    # enable the external interrupt
+    li   t5, 1 << 11
+    csrs mie, t5
+    csrsi mstatus, 8
+"""
+
+EPILOGUE = """\
+
+fuzz_done:
+    # wait for the last armed interrupt
+    beqz s9, 2f
+1:
+    beqz s11, 1b
+2:
+    csrci mstatus, 8
+"""
+
+
+def report_key(name):
+    return sum(ord(char) << (8 * i) for i, char in enumerate(name[:4]))
+
+
+def report(name, register):
+    return [f"    li   t5, {report_key(name)}", f"    sw   t5, {TEST_REPORT_KEY}(t3)",
+            f"    sw   {register}, {TEST_REPORT_VALUE}(t3)"]
+
+
+# ------------------------------------------------------------------------------------------------
+# Blocks
+
+class Block:
+    """Leaf block: fixed lines of assembly."""
+
+    def __init__(self, lines):
+        self.lines = lines
+
+    children = ()
+
+    def render(self):
+        return list(self.lines)
+
+    def count(self):
+        return 1
+
+
+class Container(Block):
+    """Block containing other blocks (head, children, tail)."""
+
+    def __init__(self, head, children, tail):
+        super().__init__([])
+        self.head = head
+        self.children = children
+        self.tail = tail
+
+    def render(self):
+        lines = list(self.head)
+        for child in self.children:
+            lines += child.render()
+        return lines + list(self.tail)
+
+    def count(self):
+        return 1 + sum(child.count() for child in self.children)
+
+
+class Program:
+    """Initial state (not shrinkable, the register file is not reset) and random blocks."""
+
+    def __init__(self, seed, init, blocks, buffer):
+        self.seed = seed
+        self.init = init
+        self.blocks = blocks
+        self.buffer = buffer
+
+    def render(self):
+        lines = [PROLOGUE.format(seed=self.seed, interrupt=TEST_INTERRUPT)]
+        lines += self.init
+        lines.append("# random blocks")
+        for block in self.blocks:
+            lines += block.render()
+        lines.append(EPILOGUE)
+        for register in REPORTED_REGISTERS:
+            lines += report(f"x{register}", f"x{register}")
+        lines += ["    csrr t6, mscratch"] + report("mscr", "t6")
+        lines += ["    csrr t6, mie"] + report("mie", "t6")
+        lines += ["    csrr t6, mstatus", "    andi t6, t6, 0x88"] + report("msta", "t6")
+        for i in range(BUFFER_WORDS):
+            lines += [f"    lw   t6, {4 * i}(t4)"] + report(f"m{i:02x}", "t6")
+        lines += ["    li   t5, 2", "    sw   t5, 0(t3)", "3:", "    j    3b", ""]
+        lines += [".data", ".align 2", "buffer:"]
+        lines += [f"    .word 0x{word:08x}" for word in self.buffer]
+        return "\n".join(lines) + "\n"
+
+    def count(self):
+        return sum(block.count() for block in self.blocks)
+
+
+# ------------------------------------------------------------------------------------------------
+# Generator
+
+class Generator:
+    def __init__(self, seed):
+        self.random = random.Random(seed)
+        self.seed = seed
+        self.labels = 0
+        self.recent = []
+
+    def label(self):
+        self.labels += 1
+        return f"L{self.labels}"
+
+    def register(self, exclude=()):
+        return self.random.choice([r for r in RANDOM_REGISTERS if r not in exclude])
+
+    def source(self):
+        # mostly one of the last written registers (forwarding paths)
+        if self.recent and self.random.random() < 0.6:
+            return self.random.choice(self.recent[-3:])
+        if self.random.random() < 0.1:
+            return 0
+        return self.register()
+
+    def destination(self, exclude):
+        # small register set, so values are reused
+        if self.random.random() < 0.7:
+            candidates = [r for r in range(1, 9) if r not in exclude]
+            if candidates:
+                rd = self.random.choice(candidates)
+            else:
+                rd = self.register(exclude)
+        else:
+            rd = self.register(exclude)
+        self.recent = (self.recent + [rd])[-4:]
+        return rd
+
+    def immediate(self, bits=12):
+        kind = self.random.random()
+        if kind < 0.3:
+            return self.random.randint(-4, 4)
+        if kind < 0.4:
+            return self.random.choice([-(1 << (bits - 1)), (1 << (bits - 1)) - 1])
+        return self.random.randint(-(1 << (bits - 1)), (1 << (bits - 1)) - 1)
+
+    # leaf blocks ---------------------------------------------------------------------------------
+
+    def alu(self, exclude):
+        rs1, rs2 = self.source(), self.source()
+        rd = self.destination(exclude)
+        kind = self.random.random()
+        if kind < 0.45:
+            return Block([f"    {self.random.choice(ALU_REG):<4} x{rd}, x{rs1}, x{rs2}"])
+        if kind < 0.8:
+            return Block([f"    {self.random.choice(ALU_IMM):<4} x{rd}, x{rs1}, {self.immediate()}"])
+        if kind < 0.9:
+            return Block([f"    {self.random.choice(SHIFT_IMM):<4} x{rd}, x{rs1}, {self.random.randint(0, 31)}"])
+        if kind < 0.95:
+            return Block([f"    lui  x{rd}, {self.random.randint(0, 0xFFFFF)}"])
+        return Block([f"    auipc x{rd}, {self.random.randint(0, 0xFFFFF)}"])
+
+    def load_store(self, exclude):
+        if self.random.random() < 0.5:
+            op, size = self.random.choice(list(LOADS.items()))
+        else:
+            op, size = self.random.choice(list(STORES.items()))
+        offset = self.random.randrange(0, BUFFER_WORDS * 4 - 4, size)
+        if self.random.random() < 0.1:
+            offset = self.random.randrange(1, BUFFER_WORDS * 4 - 4)
+        if op in LOADS:
+            return Block([f"    {op:<4} x{self.destination(exclude)}, {offset}(t4)"])
+        return Block([f"    {op:<4} x{self.source()}, {offset}(t4)"])
+
+    def peripheral(self, exclude):
+        # stall register: 3 wait states, error register: 3 wait states and a bus error
+        offset = TEST_STALL if self.random.random() < 0.7 else TEST_ERROR
+        if self.random.random() < 0.5:
+            return Block([f"    lw   x{self.destination(exclude)}, {offset}(t3)"])
+        return Block([f"    sw   x{self.source()}, {offset}(t3)"])
+
+    def csr(self, exclude):
+        rd = self.destination(exclude) if self.random.random() < 0.8 else 0
+        if self.random.random() < 0.7:
+            return Block([f"    {self.random.choice(CSR_OPS)} x{rd}, mscratch, x{self.source()}"])
+        return Block([f"    {self.random.choice(CSR_IMM_OPS)} x{rd}, mscratch, {self.random.randint(0, 31)}"])
+
+    def trap(self, exclude):
+        return Block([self.random.choice(["    ecall", "    ebreak", "    .word 0x00000000", "    .word 0xffffffff"])])
+
+    def interrupt(self, exclude):
+        # armed with interrupts disabled, the handler uses t5
+        delay = self.random.choice([1, 2, 3, 5, 8, self.random.randint(1, 64)])
+        return Block(["    csrci mstatus, 8", f"    li   t5, {delay}", f"    sw   t5, {TEST_INTERRUPT}(t3)",
+                      "    li   s9, 1", "    csrsi mstatus, 8"])
+
+    def misc(self, exclude):
+        return Block([self.random.choice(["    nop", "    fence", "    fence.i"])])
+
+    # containers ---------------------------------------------------------------------------------
+
+    def branch(self, exclude, depth):
+        label = self.label()
+        op = self.random.choice(BRANCHES)
+        head = [f"    {op:<4} x{self.source()}, x{self.source()}, {label}"]
+        return Container(head, self.blocks(self.random.randint(1, 4), exclude, depth + 1), [f"{label}:"])
+
+    def jump(self, exclude, depth):
+        label = self.label()
+        rd = self.destination(exclude) if self.random.random() < 0.7 else 0
+        if self.random.random() < 0.5:
+            head = [f"    jal  x{rd}, {label}"]
+        else:
+            base = self.register(exclude)
+            head = [f"    la   x{base}, {label}", f"    jalr x{rd}, 0(x{base})"]
+        return Container(head, self.blocks(self.random.randint(1, 3), exclude, depth + 1), [f"{label}:"])
+
+    def loop(self, exclude, depth):
+        label = self.label()
+        counter = self.register(exclude)
+        exclude = set(exclude) | {counter}
+        head = [f"    li   x{counter}, {self.random.randint(1, 4)}", f"{label}:"]
+        children = self.blocks(self.random.randint(1, 5), exclude, depth + 1)
+        return Container(head, children, [f"    addi x{counter}, x{counter}, -1", f"    bnez x{counter}, {label}"])
+
+    # ---------------------------------------------------------------------------------------------
+
+    LEAVES = [("alu", 40), ("load_store", 20), ("peripheral", 4), ("csr", 4), ("trap", 3),
+              ("interrupt", 2), ("misc", 2)]
+    CONTAINERS = [("branch", 8), ("jump", 4), ("loop", 3)]
+
+    def block(self, exclude, depth):
+        choices = self.LEAVES + (self.CONTAINERS if depth < 3 else [])
+        names = [name for name, _ in choices]
+        weights = [weight for _, weight in choices]
+        name = self.random.choices(names, weights)[0]
+        if name in dict(self.CONTAINERS):
+            return getattr(self, name)(exclude, depth)
+        return getattr(self, name)(exclude)
+
+    def blocks(self, count, exclude=(), depth=0):
+        return [self.block(exclude, depth) for _ in range(count)]
+
+    def program(self, length):
+        # initial values: small, large and random
+        init = []
+        for register in RANDOM_REGISTERS:
+            value = self.random.choice([0, 1, -1, 0x7FFFFFFF, -0x80000000, self.random.randint(-16, 16),
+                                        self.random.getrandbits(32)])
+            init.append(f"    li   x{register}, {value}")
+        init += [f"    li   t5, {self.random.getrandbits(32)}", "    csrw mscratch, t5"]
+        buffer = [self.random.getrandbits(32) for _ in range(BUFFER_WORDS)]
+        return Program(self.seed, init, self.blocks(length), buffer)
+
+
+def generate(seed, length):
+    return Generator(seed).program(length)
@@ -0,0 +1,374 @@
+# Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+# Embedded Architectures & Systems Group, Graz University of Technology
+# SPDX-License-Identifier: MIT
+# ---------------------------------------------------------------------
+# File: iss.py
+#
+# Instruction set reference for the differential fuzzing (see fuzz.py): RV32I + Zicsr in
+# machine mode with the traps of HaDes-V, the program memory, the TCM and the test peripheral
+# (lib/wishbone/wishbone_test.sv). It runs the same init.bin as the simulation and collects the
+# "REPORT <key> <value>" pairs the program sends, which describe its final architectural state.
+#
+# Timing is not modelled: the interrupt register counts instructions instead of cycles, the
+# fuzzing programs are written so that their final state does not depend on the exact moment.
+#
+# Usage (standalone):
+#   iss.py [--memory-size-kb N] init.bin
+
+import argparse
+import sys
+
+# Memory map (byte addresses, see defines/constants.sv)
+MEMORY_START = 0x10000 << 2
+TCM_START = 0x20000 << 2
+TCM_SIZE = 4096
+TEST_START = 0x120000 << 2
+TEST_SIZE = 7 * 4
+
+# Exception codes (mcause)
+FETCH_MISALIGNED = 0
+FETCH_FAULT = 1
+ILLEGAL_INSTRUCTION = 2
+BREAKPOINT = 3
+LOAD_MISALIGNED = 4
+LOAD_FAULT = 5
+STORE_MISALIGNED = 6
+STORE_FAULT = 7
+ECALL = 11
+EXTERNAL_INTERRUPT = (1 << 31) | 11
+
+# CSRs
+MSTATUS = 0x300
+MISA = 0x301
+MIE = 0x304
+MTVEC = 0x305
+MSCRATCH = 0x340
+MEPC = 0x341
+MCAUSE = 0x342
+MTVAL = 0x343
+MIP = 0x344
+
+MSTATUS_MIE = 1 << 3
+MSTATUS_MPIE = 1 << 7
+MSTATUS_MPP = 3 << 11
+MIE_MEIE = 1 << 11
+
+MASK = 0xFFFFFFFF
+
+
+class Trap(Exception):
+    def __init__(self, cause, value=0):
+        super().__init__(cause)
+        self.cause = cause
+        self.value = value
+
+
+def sign_extend(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def signed(value):
+    return sign_extend(value, 32)
+
+
+class Machine:
+    def __init__(self, image, memory_size_kb=32):
+        self.memory = bytearray(memory_size_kb * 1024)
+        self.memory[:len(image)] = image
+        self.tcm = bytearray(TCM_SIZE)
+        self.regs = [0] * 32
+        self.pc = MEMORY_START
+        self.csrs = {MSTATUS: MSTATUS_MPP, MIE: 0, MTVEC: 0, MSCRATCH: 0, MEPC: 0, MCAUSE: 0, MTVAL: 0}
+        self.reports = {}
+        self.report_key = 0
+        self.halted = False
+        self.instructions = 0
+        # test peripheral
+        self.interrupt_counter = 0
+        self.interrupt_enable = False
+        self.stall_reg = 0
+
+    # --------------------------------------------------------------------------------------------
+    # Memory
+
+    def region(self, address, size):
+        for start, data in ((MEMORY_START, self.memory), (TCM_START, self.tcm)):
+            if start <= address and address + size <= start + len(data):
+                return data, address - start
+        return None, 0
+
+    def load(self, address, size):
+        if address % size != 0:
+            raise Trap(LOAD_MISALIGNED, address)
+        data, offset = self.region(address, size)
+        if data is not None:
+            return int.from_bytes(data[offset:offset + size], "little")
+        if TEST_START <= address < TEST_START + TEST_SIZE and size == 4:
+            return self.test_read((address - TEST_START) // 4)
+        raise Trap(LOAD_FAULT, address)
+
+    def store(self, address, size, value):
+        if address % size != 0:
+            raise Trap(STORE_MISALIGNED, address)
+        data, offset = self.region(address, size)
+        if data is not None:
+            data[offset:offset + size] = (value & ((1 << (8 * size)) - 1)).to_bytes(size, "little")
+            return
+        if TEST_START <= address < TEST_START + TEST_SIZE and size == 4:
+            self.test_write((address - TEST_START) // 4, value)
+            return
+        raise Trap(STORE_FAULT, address)
+
+    def test_read(self, register):
+        if register == 1:
+            return self.interrupt_counter
+        if register == 3:
+            return self.stall_reg
+        if register == 4:
+            raise Trap(LOAD_FAULT, TEST_START + 16)
+        if register == 5:
+            return self.report_key
+        return 0
+
+    def test_write(self, register, value):
+        if register == 0:
+            self.halted = value == 2
+        elif register == 1:
+            self.interrupt_counter = value
+            self.interrupt_enable = value > 0
+        elif register == 3:
+            self.stall_reg = value
+        elif register == 4:
+            raise Trap(STORE_FAULT, TEST_START + 16)
+        elif register == 5:
+            self.report_key = value
+        elif register == 6:
+            self.reports[report_key_string(self.report_key)] = value
+
+    # --------------------------------------------------------------------------------------------
+    # CSRs
+
+    def csr_read(self, number):
+        if number == MIP:
+            return MIE_MEIE if self.interrupt_pending() else 0
+        if number == MISA:
+            return (1 << 30) | (1 << 8)  # RV32I
+        if number not in self.csrs:
+            raise Trap(ILLEGAL_INSTRUCTION)
+        return self.csrs[number]
+
+    def csr_write(self, number, value):
+        if number not in self.csrs:
+            raise Trap(ILLEGAL_INSTRUCTION)
+        if number in (MTVEC, MEPC):
+            value &= ~3
+        self.csrs[number] = value & MASK
+
+    # --------------------------------------------------------------------------------------------
+    # Traps
+
+    def interrupt_pending(self):
+        return self.interrupt_enable and self.interrupt_counter == 0
+
+    def trap(self, cause, value=0):
+        mstatus = self.csrs[MSTATUS]
+        mpie = MSTATUS_MPIE if mstatus & MSTATUS_MIE else 0
+        self.csrs[MSTATUS] = (mstatus & ~(MSTATUS_MIE | MSTATUS_MPIE)) | mpie | MSTATUS_MPP
+        self.csrs[MEPC] = self.pc
+        self.csrs[MCAUSE] = cause
+        self.csrs[MTVAL] = value & MASK
+        self.pc = self.csrs[MTVEC] & ~3
+
+    def mret(self):
+        mstatus = self.csrs[MSTATUS]
+        mie = MSTATUS_MIE if mstatus & MSTATUS_MPIE else 0
+        self.csrs[MSTATUS] = (mstatus & ~MSTATUS_MIE) | mie | MSTATUS_MPIE
+        return self.csrs[MEPC]
+
+    # --------------------------------------------------------------------------------------------
+    # Execution
+
+    def step(self):
+        if self.interrupt_counter > 0:
+            self.interrupt_counter -= 1
+        if (self.interrupt_pending() and self.csrs[MSTATUS] & MSTATUS_MIE
+                and self.csrs[MIE] & MIE_MEIE):
+            self.trap(EXTERNAL_INTERRUPT)
+            return
+        try:
+            if self.pc % 4 != 0:
+                raise Trap(FETCH_MISALIGNED, self.pc)
+            data, offset = self.region(self.pc, 4)
+            if data is None:
+                raise Trap(FETCH_FAULT, self.pc)
+            word = int.from_bytes(data[offset:offset + 4], "little")
+            self.pc = self.execute(word) & MASK
+        except Trap as trap:
+            self.trap(trap.cause, trap.value)
+        self.regs[0] = 0
+        self.instructions += 1
+
+    def run(self, max_instructions):
+        while not self.halted and self.instructions < max_instructions:
+            self.step()
+        return self.halted
+
+    def execute(self, word):
+        regs = self.regs
+        pc = self.pc
+        opcode = word & 0x7F
+        rd = (word >> 7) & 0x1F
+        funct3 = (word >> 12) & 0x7
+        rs1 = (word >> 15) & 0x1F
+        rs2 = (word >> 20) & 0x1F
+        funct7 = word >> 25
+        a = regs[rs1]
+        b = regs[rs2]
+        imm_i = sign_extend(word >> 20, 12)
+        imm_s = sign_extend(((word >> 25) << 5) | ((word >> 7) & 0x1F), 12)
+        imm_b = sign_extend(((word >> 31) << 12) | (((word >> 7) & 1) << 11)
+                            | (((word >> 25) & 0x3F) << 5) | (((word >> 8) & 0xF) << 1), 13)
+        imm_u = word & 0xFFFFF000
+        imm_j = sign_extend(((word >> 31) << 20) | (((word >> 12) & 0xFF) << 12)
+                            | (((word >> 20) & 1) << 11) | (((word >> 21) & 0x3FF) << 1), 21)
+
+        def write(value):
+            if rd != 0:
+                regs[rd] = value & MASK
+
+        def jump(target):
+            target &= MASK
+            if target % 4 != 0:
+                raise Trap(FETCH_MISALIGNED, target)
+            return target
+
+        if opcode == 0x37:  # LUI
+            write(imm_u)
+        elif opcode == 0x17:  # AUIPC
+            write(pc + imm_u)
+        elif opcode == 0x6F:  # JAL
+            target = jump(pc + imm_j)
+            write(pc + 4)
+            return target
+        elif opcode == 0x67 and funct3 == 0:  # JALR
+            target = jump((a + imm_i) & ~1)
+            write(pc + 4)
+            return target
+        elif opcode == 0x63 and funct3 not in (2, 3):  # branches
+            taken = {
+                0: a == b,
+                1: a != b,
+                4: signed(a) < signed(b),
+                5: signed(a) >= signed(b),
+                6: a < b,
+                7: a >= b,
+            }[funct3]
+            if taken:
+                return jump(pc + imm_b)
+        elif opcode == 0x03 and funct3 in (0, 1, 2, 4, 5):  # loads
+            size = 1 << (funct3 & 3)
+            value = self.load((a + imm_i) & MASK, size)
+            write(sign_extend(value, 8 * size) if funct3 < 4 else value)
+        elif opcode == 0x23 and funct3 in (0, 1, 2):  # stores
+            self.store((a + imm_s) & MASK, 1 << funct3, b)
+        elif opcode == 0x13:  # OP-IMM
+            shamt = rs2
+            if funct3 == 0:
+                write(a + imm_i)
+            elif funct3 == 2:
+                write(int(signed(a) < imm_i))
+            elif funct3 == 3:
+                write(int(a < (imm_i & MASK)))
+            elif funct3 == 4:
+                write(a ^ imm_i)
+            elif funct3 == 6:
+                write(a | imm_i)
+            elif funct3 == 7:
+                write(a & imm_i)
+            elif funct3 == 1 and funct7 == 0:
+                write(a << shamt)
+            elif funct3 == 5 and funct7 == 0:
+                write(a >> shamt)
+            elif funct3 == 5 and funct7 == 0x20:
+                write(signed(a) >> shamt)
+            else:
+                raise Trap(ILLEGAL_INSTRUCTION, word)
+        elif opcode == 0x33 and funct7 in (0, 0x20):  # OP
+            shamt = b & 0x1F
+            operations = {
+                (0, 0): lambda: a + b,
+                (0, 0x20): lambda: a - b,
+                (1, 0): lambda: a << shamt,
+                (2, 0): lambda: int(signed(a) < signed(b)),
+                (3, 0): lambda: int(a < b),
+                (4, 0): lambda: a ^ b,
+                (5, 0): lambda: a >> shamt,
+                (5, 0x20): lambda: signed(a) >> shamt,
+                (6, 0): lambda: a | b,
+                (7, 0): lambda: a & b,
+            }
+            if (funct3, funct7) not in operations:
+                raise Trap(ILLEGAL_INSTRUCTION, word)
+            write(operations[(funct3, funct7)]())
+        elif opcode == 0x0F and funct3 in (0, 1):  # FENCE, FENCE.I
+            pass
+        elif opcode == 0x73 and funct3 == 0:
+            if word == 0x00000073:
+                raise Trap(ECALL)
+            if word == 0x00100073:
+                raise Trap(BREAKPOINT)
+            if word == 0x30200073:  # MRET
+                return self.mret()
+            if word == 0x10500073:  # WFI
+                pass
+            else:
+                raise Trap(ILLEGAL_INSTRUCTION, word)
+        elif opcode == 0x73 and funct3 != 4:  # Zicsr
+            number = word >> 20
+            source = rs1 if funct3 & 4 else a
+            writes = funct3 & 3 == 1 or rs1 != 0
+            old = self.csr_read(number) if funct3 & 3 != 1 or rd != 0 else 0
+            if writes:
+                if funct3 & 3 == 1:
+                    self.csr_write(number, source)
+                elif funct3 & 3 == 2:
+                    self.csr_write(number, old | source)
+                else:
+                    self.csr_write(number, old & ~source)
+            write(old)
+        else:
+            raise Trap(ILLEGAL_INSTRUCTION, word)
+        return pc + 4
+
+
+def report_key_string(key):
+    return "".join(chr((key >> (8 * i)) & 0xFF) for i in range(4) if (key >> (8 * i)) & 0xFF)
+
+
+def run(image, memory_size_kb=32, max_instructions=1000000):
+    """Runs the program, returns (halted, reports)."""
+    machine = Machine(image, memory_size_kb)
+    halted = machine.run(max_instructions)
+    return halted, machine.reports
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a HaDes-V program on the instruction set reference")
+    parser.add_argument("image", help="init.bin (loaded at the start of the program memory)")
+    parser.add_argument("--memory-size-kb", type=int, default=32)
+    parser.add_argument("--max-instructions", type=int, default=1000000)
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as image_file:
+        halted, reports = run(image_file.read(), args.memory_size_kb, args.max_instructions)
+    for key, value in reports.items():
+        print(f"REPORT {key} {value}")
+    if not halted:
+        print("Instruction limit reached")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,178 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: lockstep.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Shared parts of the lockstep testbenches (test/sv/lockstep_*.sv).                            |
+// | Each testbench runs the rtl stage and its ref_* counterpart side by side on the same random  |
+// | inputs and compares all outputs every cycle. This package holds the constrained-random       |
+// | generators for the stage interfaces and the mismatch bookkeeping.                            |
+// |                                                                                              |
+// | Plusargs of all lockstep testbenches:                                                        |
+// |     +cycles=<n>   number of random cycles (default 20000)                                    |
+// |     +seed=<n>     seed of the random generators (default 1)                                  |
+// |     +continue     don't stop at the first mismatch                                           |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+/*verilator lint_off UNUSED*/
+
+package lockstep;
+    import pipeline_status::*;
+
+    int  mismatches = 0;
+    bit  stop_on_mismatch = 1;
+    int  cycles = 20000;
+
+    function automatic void setup();
+        int seed = 1;
+        void'($value$plusargs("cycles=%d", cycles));
+        void'($value$plusargs("seed=%d", seed));
+        stop_on_mismatch = !$test$plusargs("continue");
+        void'($urandom(seed));
+        $display("Lockstep: %0d cycles, seed %0d", cycles, seed);
+    endfunction
+
+    // --------------------------------------------------------------------------------------------
+    // |                                        Comparison                                        |
+    // --------------------------------------------------------------------------------------------
+
+    // Returns 1 on a mismatch, the first one is reported with cycle and port name
+    function automatic bit check(longint cycle, string port, logic [127:0] dut_value, logic [127:0] ref_value);
+        if (dut_value === ref_value) begin
+            return 0;
+        end
+        mismatches++;
+        if (mismatches == 1 || !stop_on_mismatch) begin
+            $display("\033[0;31m(cycle %0d) Mismatch at %s: rtl = 0x%0h, ref = 0x%0h\033[0m", cycle, port, dut_value, ref_value);
+        end
+        return 1;
+    endfunction
+
+    function automatic void print_done(string stage);
+        if (mismatches != 0) begin
+            $display("\033[0;31m"); // color_red
+            $display("%s: rtl and ref differ! (# Mismatches: %0d)", stage, mismatches);
+        end
+        else begin
+            $display("\033[0;32m"); // color green
+            $display("%s: rtl and ref match for %0d cycles!", stage, cycles);
+        end
+        $display("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
+        $display("!!!!!!!!!!!!!!!!!!!! TEST DONE !!!!!!!!!!!!!!!!!!!!");
+        $display("!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
+        $display("\033[0m"); // color off
+    endfunction
+
+    // --------------------------------------------------------------------------------------------
+    // |                                    Random generators                                     |
+    // --------------------------------------------------------------------------------------------
+
+    // True with the given probability in percent
+    function automatic bit chance(int percent);
+        return $urandom_range(99) < percent;
+    endfunction
+
+    function automatic forwards_t random_forwards();
+        int pick = $urandom_range(99);
+        if (pick < 70) return VALID;
+        if (pick < 95) return BUBBLE;
+        return forwards_t'($urandom_range(EBREAK, FETCH_MISALIGNED));
+    endfunction
+
+    function automatic backwards_t random_backwards();
+        int pick = $urandom_range(99);
+        if (pick < 80) return READY;
+        if (pick < 95) return STALL;
+        return JUMP;
+    endfunction
+
+    // Mostly small register numbers, so dependencies between instructions are likely
+    function automatic logic [4:0] random_register();
+        return chance(75) ? 5'($urandom_range(3)) : 5'($urandom);
+    endfunction
+
+    // Word aligned address in the program memory, sometimes misaligned or outside
+    function automatic logic [31:0] random_address();
+        if (chance(5)) return $urandom;
+        if (chance(5)) return (constants::MEMORY_START << 2) + $urandom_range(1023) * 4 + $urandom_range(1, 3);
+        return (constants::MEMORY_START << 2) + $urandom_range(1023) * 4;
+    endfunction
+
+    function automatic logic [31:0] random_data();
+        case ($urandom_range(3))
+            0: return 0;
+            1: return 32'($signed($urandom_range(31)) - 16);
+            2: return 32'h8000_0000 >> $urandom_range(31);
+            default: return $urandom;
+        endcase
+    endfunction
+
+    function automatic logic [11:0] random_csr();
+        logic [11:0] csrs[14] = '{12'h300, 12'h304, 12'h305, 12'h340, 12'h341, 12'h342, 12'h343,
+                                  12'h344, 12'hB00, 12'hB02, 12'hB80, 12'hB82, 12'hF14, 12'h7C0};
+        return chance(95) ? csrs[$urandom_range($size(csrs) - 1)] : 12'($urandom);
+    endfunction
+
+    function automatic forwarding::t random_forwarding();
+        forwarding::t result;
+        result.data_valid = chance(70);
+        result.data       = random_data();
+        result.address    = random_register();
+        return result;
+    endfunction
+
+    // Raw RV32I + Zicsr encoding, weighted towards the common instructions
+    function automatic logic [31:0] random_instruction();
+        logic [4:0]  rd  = random_register();
+        logic [4:0]  rs1 = random_register();
+        logic [4:0]  rs2 = random_register();
+        logic [31:0] imm = chance(50) ? 32'($signed($urandom_range(63)) - 32) : $urandom;
+        logic [2:0]  funct3 = 3'($urandom);
+        logic [2:0]  branch_funct3[6] = '{3'b000, 3'b001, 3'b100, 3'b101, 3'b110, 3'b111};
+        logic [2:0]  csr_funct3[6]    = '{3'b001, 3'b010, 3'b011, 3'b101, 3'b110, 3'b111};
+        logic [31:0] system[4]        = '{32'h00000073, 32'h00100073, 32'h30200073, 32'h10500073};
+
+        case ($urandom_range(19))
+            0:  return {imm[31:12], rd, 7'b0110111};                                    // lui
+            1:  return {imm[31:12], rd, 7'b0010111};                                    // auipc
+            2:  return {imm[20], imm[10:1], imm[11], imm[19:12], rd, 7'b1101111};       // jal
+            3:  return {imm[11:0], rs1, 3'b000, rd, 7'b1100111};                        // jalr
+            4, 5: return {imm[12], imm[10:5], rs2, rs1, branch_funct3[$urandom_range(5)], imm[4:1], imm[11], 7'b1100011}; // branch
+            6, 7: return {imm[11:0], rs1, funct3, rd, 7'b0000011};                      // load
+            8:  return {imm[11:5], rs2, rs1, 3'($urandom_range(2)), imm[4:0], 7'b0100011}; // store
+            9, 10, 11: begin                                                            // op-imm
+                if (funct3 == 3'b001)      return {7'b0, imm[4:0], rs1, funct3, rd, 7'b0010011};
+                else if (funct3 == 3'b101) return {chance(50) ? 7'b0100000 : 7'b0, imm[4:0], rs1, funct3, rd, 7'b0010011};
+                else                       return {imm[11:0], rs1, funct3, rd, 7'b0010011};
+            end
+            12, 13, 14: return {(funct3 == 3'b000 || funct3 == 3'b101) && chance(50) ? 7'b0100000 : 7'b0,
+                                rs2, rs1, funct3, rd, 7'b0110011};                      // op
+            15: return {random_csr(), rs1, csr_funct3[$urandom_range(5)], rd, 7'b1110011};  // csr
+            16: return system[$urandom_range(3)];                                       // ecall, ebreak, mret, wfi
+            17: return chance(50) ? 32'h0ff0000f : 32'h0000100f;                        // fence, fence.i
+            18: return 32'h00000013;                                                    // nop
+            default: return $urandom;                                                   // (mostly) illegal
+        endcase
+    endfunction
+
+    // Decoded instruction (inputs of execute, memory and writeback)
+    function automatic instruction::t random_decoded();
+        instruction::t result;
+        result.op          = op::t'($urandom_range(op::ILLEGAL));
+        result.rd_address  = random_register();
+        result.rs1_address = random_register();
+        result.rs2_address = random_register();
+        result.csr         = csr::t'(random_csr());
+        result.immediate   = chance(50) ? 32'($signed($urandom_range(63)) - 32) : random_data();
+        return result;
+    endfunction
+endpackage
+
+/*verilator lint_on UNUSED*/
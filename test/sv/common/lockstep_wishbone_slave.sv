@@ -0,0 +1,64 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: lockstep_wishbone_slave.sv
+ */
+
+
+
+// ------------------------------------------------------------------------------------------------
+// |                                                                                              |
+// | Random wishbone slave for the lockstep testbenches.                                          |
+// | Answers the requests of the rtl stage after 0 to MAX_LATENCY cycles, with an error in        |
+// | ERROR_PERCENT of the transactions. Reads return random instruction words (INSTRUCTIONS = 1)  |
+// | or random data. The golden port receives exactly the same responses, differences in the     |
+// | requests of both stages are found by the output comparison of the testbench.                 |
+// |                                                                                              |
+// ------------------------------------------------------------------------------------------------
+
+module lockstep_wishbone_slave #(
+    parameter int MAX_LATENCY   = 3,
+    parameter int ERROR_PERCENT = 2,
+    parameter bit INSTRUCTIONS  = 0
+) (
+    input logic clk,
+    input logic rst,
+
+    wishbone_interface.slave dut,
+    wishbone_interface.slave golden
+);
+
+    int          count;
+    int          delay;
+    bit          error;
+    logic [31:0] data;
+
+    logic request, done;
+    assign request = dut.cyc && dut.stb;
+    assign done    = request && count == delay;
+
+    always_ff @(posedge clk) begin
+        if (rst || !request || done) begin
+            count <= 0;
+            if (rst || done) begin
+                // response of the next transaction
+                delay <= $urandom_range(MAX_LATENCY);
+                error <= lockstep::chance(ERROR_PERCENT);
+                data  <= INSTRUCTIONS ? lockstep::random_instruction() : lockstep::random_data();
+            end
+        end
+        else begin
+            count <= count + 1;
+        end
+    end
+
+    assign dut.ack      = done && !error;
+    assign dut.err      = done && error;
+    assign dut.dat_miso = data;
+
+    assign golden.ack      = dut.ack;
+    assign golden.err      = dut.err;
+    assign golden.dat_miso = dut.dat_miso;
+
+endmodule
@@ -0,0 +1,109 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: lockstep_fetch.sv
+ */
+
+`include "lockstep.svh"
+
+module lockstep_fetch;
+    // --------------------------------------------------------------------------------------------
+    // Runs rtl/fetch_stage.sv and ref_fetch_stage in lockstep on random inputs and reports the
+    // first output that differs (see test/sv/common/lockstep.sv for the plusargs).
+    // --------------------------------------------------------------------------------------------
+    import pipeline_status::*;
+
+    logic clk;
+    logic rst;
+
+    `LOCKSTEP_CLOCK
+
+    // --------------------------------------------------------------------------------------------
+    // inputs (shared)
+    backwards_t  status_backwards_in;
+    logic [31:0] jump_address_backwards_in;
+
+    // outputs
+    logic [31:0] dut_instruction_reg_out,     golden_instruction_reg_out;
+    logic [31:0] dut_program_counter_reg_out, golden_program_counter_reg_out;
+    forwards_t   dut_status_forwards_out,     golden_status_forwards_out;
+
+    wishbone_interface wb_dut();
+    wishbone_interface wb_golden();
+
+    lockstep_wishbone_slave #(
+        .INSTRUCTIONS(1)
+    ) memory (
+        .clk(clk),
+        .rst(rst),
+        .dut(wb_dut.slave),
+        .golden(wb_golden.slave)
+    );
+
+    // --------------------------------------------------------------------------------------------
+    // stages under test
+    fetch_stage dut (
+        .clk(clk),
+        .rst(rst),
+        .wb(wb_dut.master),
+        .instruction_reg_out(dut_instruction_reg_out),
+        .program_counter_reg_out(dut_program_counter_reg_out),
+        .status_forwards_out(dut_status_forwards_out),
+        .status_backwards_in(status_backwards_in),
+        .jump_address_backwards_in(jump_address_backwards_in)
+    );
+
+    ref_fetch_stage golden (
+        .clk(clk),
+        .rst(rst),
+        .wb(wb_golden.master),
+        .instruction_reg_out(golden_instruction_reg_out),
+        .program_counter_reg_out(golden_program_counter_reg_out),
+        .status_forwards_out(golden_status_forwards_out),
+        .status_backwards_in(status_backwards_in),
+        .jump_address_backwards_in(jump_address_backwards_in)
+    );
+
+    // --------------------------------------------------------------------------------------------
+    // |                                    Main Test Function                                    |
+    // --------------------------------------------------------------------------------------------
+    initial begin
+        $dumpfile("lockstep_fetch.fst");
+        $dumpvars;
+
+        lockstep::setup();
+        randomize_inputs();
+        rst = 1;
+        repeat (2) @(posedge clk);
+        #1;
+        rst = 0;
+
+        for (longint cycle = 0; cycle < lockstep::cycles; cycle++) begin
+            @(negedge clk);
+            compare(cycle);
+            if (lockstep::mismatches > 0 && lockstep::stop_on_mismatch) break;
+            @(posedge clk); #1;
+            randomize_inputs();
+        end
+
+        lockstep::print_done("fetch_stage");
+        $finish();
+    end
+
+    // --------------------------------------------------------------------------------------------
+    function void randomize_inputs();
+        status_backwards_in       = lockstep::random_backwards();
+        jump_address_backwards_in = lockstep::random_address();
+    endfunction
+
+    function void compare(longint cycle);
+        `LOCKSTEP_CHECK(status_forwards_out);
+        if (dut_status_forwards_out != BUBBLE) begin
+            `LOCKSTEP_CHECK(instruction_reg_out);
+            `LOCKSTEP_CHECK(program_counter_reg_out);
+        end
+        `LOCKSTEP_CHECK_WISHBONE(wb_dut, wb_golden)
+    endfunction
+
+endmodule
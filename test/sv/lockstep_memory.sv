@@ -0,0 +1,178 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: lockstep_memory.sv
+ */
+
+`include "lockstep.svh"
+
+module lockstep_memory;
+    // --------------------------------------------------------------------------------------------
+    // Runs rtl/memory_stage.sv and ref_memory_stage in lockstep on random inputs and reports the
+    // first output that differs (see test/sv/common/lockstep.sv for the plusargs).
+    // --------------------------------------------------------------------------------------------
+    import pipeline_status::*;
+
+    logic clk;
+    logic rst;
+
+    `LOCKSTEP_CLOCK
+
+    // --------------------------------------------------------------------------------------------
+    // inputs (shared)
+    logic [31:0]   source_data_in;
+    logic [31:0]   rd_data_in;
+    instruction::t instruction_in;
+    logic [31:0]   program_counter_in;
+    logic [31:0]   next_program_counter_in;
+    forwards_t     status_forwards_in;
+    backwards_t    status_backwards_in;
+    logic [31:0]   jump_address_backwards_in;
+
+    // outputs
+    logic [31:0]   dut_source_data_reg_out,          golden_source_data_reg_out;
+    logic [31:0]   dut_rd_data_reg_out,              golden_rd_data_reg_out;
+    instruction::t dut_instruction_reg_out,          golden_instruction_reg_out;
+    logic [31:0]   dut_program_counter_reg_out,      golden_program_counter_reg_out;
+    logic [31:0]   dut_next_program_counter_reg_out, golden_next_program_counter_reg_out;
+    forwarding::t  dut_forwarding_out,               golden_forwarding_out;
+    forwards_t     dut_status_forwards_out,          golden_status_forwards_out;
+    backwards_t    dut_status_backwards_out,         golden_status_backwards_out;
+    logic [31:0]   dut_jump_address_backwards_out,   golden_jump_address_backwards_out;
+
+    wishbone_interface wb_dut();
+    wishbone_interface wb_golden();
+
+    lockstep_wishbone_slave #(
+        .INSTRUCTIONS(0)
+    ) memory (
+        .clk(clk),
+        .rst(rst),
+        .dut(wb_dut.slave),
+        .golden(wb_golden.slave)
+    );
+
+    // --------------------------------------------------------------------------------------------
+    // stages under test
+    memory_stage dut (
+        .clk(clk),
+        .rst(rst),
+        .wb(wb_dut.master),
+        .source_data_in(source_data_in),
+        .rd_data_in(rd_data_in),
+        .instruction_in(instruction_in),
+        .program_counter_in(program_counter_in),
+        .next_program_counter_in(next_program_counter_in),
+        .source_data_reg_out(dut_source_data_reg_out),
+        .rd_data_reg_out(dut_rd_data_reg_out),
+        .instruction_reg_out(dut_instruction_reg_out),
+        .program_counter_reg_out(dut_program_counter_reg_out),
+        .next_program_counter_reg_out(dut_next_program_counter_reg_out),
+        .forwarding_out(dut_forwarding_out),
+        .status_forwards_in(status_forwards_in),
+        .status_forwards_out(dut_status_forwards_out),
+        .status_backwards_in(status_backwards_in),
+        .status_backwards_out(dut_status_backwards_out),
+        .jump_address_backwards_in(jump_address_backwards_in),
+        .jump_address_backwards_out(dut_jump_address_backwards_out)
+    );
+
+    ref_memory_stage golden (
+        .clk(clk),
+        .rst(rst),
+        .wb(wb_golden.master),
+        .source_data_in(source_data_in),
+        .rd_data_in(rd_data_in),
+        .instruction_in(instruction_in),
+        .program_counter_in(program_counter_in),
+        .next_program_counter_in(next_program_counter_in),
+        .source_data_reg_out(golden_source_data_reg_out),
+        .rd_data_reg_out(golden_rd_data_reg_out),
+        .instruction_reg_out(golden_instruction_reg_out),
+        .program_counter_reg_out(golden_program_counter_reg_out),
+        .next_program_counter_reg_out(golden_next_program_counter_reg_out),
+        .forwarding_out(golden_forwarding_out),
+        .status_forwards_in(status_forwards_in),
+        .status_forwards_out(golden_status_forwards_out),
+        .status_backwards_in(status_backwards_in),
+        .status_backwards_out(golden_status_backwards_out),
+        .jump_address_backwards_in(jump_address_backwards_in),
+        .jump_address_backwards_out(golden_jump_address_backwards_out)
+    );
+
+    // --------------------------------------------------------------------------------------------
+    // |                                    Main Test Function                                    |
+    // --------------------------------------------------------------------------------------------
+    initial begin
+        $dumpfile("lockstep_memory.fst");
+        $dumpvars;
+
+        lockstep::setup();
+        randomize_forward_inputs();
+        randomize_backward_inputs();
+        rst = 1;
+        repeat (2) @(posedge clk);
+        #1;
+        rst = 0;
+
+        for (longint cycle = 0; cycle < lockstep::cycles; cycle++) begin
+            @(negedge clk);
+            compare(cycle);
+            if (lockstep::mismatches > 0 && lockstep::stop_on_mismatch) break;
+            @(posedge clk); #1;
+            // the previous stage holds its outputs while this stage stalls
+            if (dut_status_backwards_out != STALL) begin
+                randomize_forward_inputs();
+            end
+            randomize_backward_inputs();
+        end
+
+        lockstep::print_done("memory_stage");
+        $finish();
+    end
+
+    // --------------------------------------------------------------------------------------------
+    function void randomize_forward_inputs();
+        source_data_in = lockstep::random_data();
+        instruction_in = lockstep::random_decoded();
+        // mostly loads and stores, the address is mostly in the memory and sometimes misaligned
+        if (lockstep::chance(60)) begin
+            instruction_in.op = op::t'($urandom_range(op::LB, op::SW));
+            rd_data_in        = lockstep::random_address();
+        end
+        else begin
+            rd_data_in = lockstep::random_data();
+        end
+        program_counter_in      = lockstep::random_address();
+        next_program_counter_in = program_counter_in + 4;
+        status_forwards_in      = lockstep::random_forwards();
+    endfunction
+
+    function void randomize_backward_inputs();
+        status_backwards_in       = lockstep::random_backwards();
+        jump_address_backwards_in = lockstep::random_address();
+    endfunction
+
+    function void compare(longint cycle);
+        `LOCKSTEP_CHECK(status_forwards_out);
+        `LOCKSTEP_CHECK(status_backwards_out);
+        `LOCKSTEP_CHECK(forwarding_out.data_valid);
+        if (dut_forwarding_out.data_valid) begin
+            `LOCKSTEP_CHECK(forwarding_out.address);
+            `LOCKSTEP_CHECK(forwarding_out.data);
+        end
+        if (dut_status_forwards_out != BUBBLE) begin
+            `LOCKSTEP_CHECK(source_data_reg_out);
+            `LOCKSTEP_CHECK(rd_data_reg_out);
+            `LOCKSTEP_CHECK(instruction_reg_out);
+            `LOCKSTEP_CHECK(program_counter_reg_out);
+            `LOCKSTEP_CHECK(next_program_counter_reg_out);
+        end
+        if (dut_status_backwards_out == JUMP) begin
+            `LOCKSTEP_CHECK(jump_address_backwards_out);
+        end
+        `LOCKSTEP_CHECK_WISHBONE(wb_dut, wb_golden)
+    endfunction
+
+endmodule
@@ -0,0 +1,133 @@
+/* Copyright (c) 2024 Tobias Scheipel, David Beikircher, Florian Riedl
+ * Embedded Architectures & Systems Group, Graz University of Technology
+ * SPDX-License-Identifier: MIT
+ * ---------------------------------------------------------------------
+ * File: lockstep_writeback.sv
+ */
+
+`include "lockstep.svh"
+
+module lockstep_writeback;
+    // --------------------------------------------------------------------------------------------
+    // Runs rtl/writeback_stage.sv and ref_writeback_stage in lockstep on random inputs and reports
+    // the first output that differs (see test/sv/common/lockstep.sv for the plusargs).
+    // --------------------------------------------------------------------------------------------
+    import pipeline_status::*;
+
+    logic clk;
+    logic rst;
+
+    `LOCKSTEP_CLOCK
+
+    // --------------------------------------------------------------------------------------------
+    // inputs (shared)
+    logic [31:0]   source_data_in;
+    logic [31:0]   rd_data_in;
+    instruction::t instruction_in;
+    logic [31:0]   program_counter_in;
+    logic [31:0]   next_program_counter_in;
+    logic          external_interrupt_in;
+    logic          timer_interrupt_in;
+    forwards_t     status_forwards_in;
+
+    // outputs
+    forwarding::t dut_forwarding_out,             golden_forwarding_out;
+    backwards_t   dut_status_backwards_out,       golden_status_backwards_out;
+    logic [31:0]  dut_jump_address_backwards_out, golden_jump_address_backwards_out;
+
+    // --------------------------------------------------------------------------------------------
+    // stages under test
+    writeback_stage dut (
+        .clk(clk),
+        .rst(rst),
+        .source_data_in(source_data_in),
+        .rd_data_in(rd_data_in),
+        .instruction_in(instruction_in),
+        .program_counter_in(program_counter_in),
+        .next_program_counter_in(next_program_counter_in),
+        .external_interrupt_in(external_interrupt_in),
+        .timer_interrupt_in(timer_interrupt_in),
+        .forwarding_out(dut_forwarding_out),
+        .status_forwards_in(status_forwards_in),
+        .status_backwards_out(dut_status_backwards_out),
+        .jump_address_backwards_out(dut_jump_address_backwards_out)
+    );
+
+    ref_writeback_stage golden (
+        .clk(clk),
+        .rst(rst),
+        .source_data_in(source_data_in),
+        .rd_data_in(rd_data_in),
+        .instruction_in(instruction_in),
+        .program_counter_in(program_counter_in),
+        .next_program_counter_in(next_program_counter_in),
+        .external_interrupt_in(external_interrupt_in),
+        .timer_interrupt_in(timer_interrupt_in),
+        .forwarding_out(golden_forwarding_out),
+        .status_forwards_in(status_forwards_in),
+        .status_backwards_out(golden_status_backwards_out),
+        .jump_address_backwards_out(golden_jump_address_backwards_out)
+    );
+
+    // --------------------------------------------------------------------------------------------
+    // |                                    Main Test Function                                    |
+    // --------------------------------------------------------------------------------------------
+    initial begin
+        $dumpfile("lockstep_writeback.fst");
+        $dumpvars;
+
+        lockstep::setup();
+        randomize_inputs();
+        rst = 1;
+        repeat (2) @(posedge clk);
+        #1;
+        rst = 0;
+
+        for (longint cycle = 0; cycle < lockstep::cycles; cycle++) begin
+            @(negedge clk);
+            compare(cycle);
+            if (lockstep::mismatches > 0 && lockstep::stop_on_mismatch) break;
+            @(posedge clk); #1;
+            // the previous stage holds its outputs while this stage stalls
+            if (dut_status_backwards_out != STALL) begin
+                randomize_inputs();
+            end
+            else begin
+                randomize_interrupts();
+            end
+        end
+
+        lockstep::print_done("writeback_stage");
+        $finish();
+    end
+
+    // --------------------------------------------------------------------------------------------
+    function void randomize_inputs();
+        source_data_in          = lockstep::random_data();
+        rd_data_in              = lockstep::random_data();
+        instruction_in          = lockstep::random_decoded();
+        program_counter_in      = lockstep::random_address();
+        next_program_counter_in = lockstep::chance(80) ? program_counter_in + 4 : lockstep::random_address();
+        status_forwards_in      = lockstep::random_forwards();
+        randomize_interrupts();
+    endfunction
+
+    // interrupt lines are level signals, they stay active for a while
+    function void randomize_interrupts();
+        if (lockstep::chance(5)) external_interrupt_in = lockstep::chance(50);
+        if (lockstep::chance(5)) timer_interrupt_in    = lockstep::chance(50);
+    endfunction
+
+    function void compare(longint cycle);
+        `LOCKSTEP_CHECK(status_backwards_out);
+        `LOCKSTEP_CHECK(forwarding_out.data_valid);
+        if (dut_forwarding_out.data_valid) begin
+            `LOCKSTEP_CHECK(forwarding_out.address);
+            `LOCKSTEP_CHECK(forwarding_out.data);
+        end
+        if (dut_status_backwards_out == JUMP) begin
+            `LOCKSTEP_CHECK(jump_address_backwards_out);
+        end
+    endfunction
+
+endmodule